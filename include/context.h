@@ -22,6 +22,9 @@ namespace client {
 namespace options {
 class Options;
 } // namespace options
+namespace util {
+class TimingWheel;
+} // namespace util
 
 class Context {
 public:
@@ -31,6 +34,9 @@ public:
     std::shared_ptr<Scheduler> scheduler() const;
     void setScheduler(std::shared_ptr<Scheduler> scheduler);
 
+    std::shared_ptr<util::TimingWheel> timingWheel() const;
+    void setTimingWheel(std::shared_ptr<util::TimingWheel> timingWheel);
+
     std::shared_ptr<communication::Communicator> communicator() const;
     void setCommunicator(
         std::shared_ptr<communication::Communicator> communicator);
@@ -38,10 +44,12 @@ public:
 private:
     std::shared_ptr<options::Options> m_options;
     std::shared_ptr<Scheduler> m_scheduler;
+    std::shared_ptr<util::TimingWheel> m_timingWheel;
     std::shared_ptr<communication::Communicator> m_communicator;
 
     mutable std::shared_timed_mutex m_optionsMutex;
     mutable std::shared_timed_mutex m_schedulerMutex;
+    mutable std::shared_timed_mutex m_timingWheelMutex;
     mutable std::shared_timed_mutex m_communicatorMutex;
 };
 
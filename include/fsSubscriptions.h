@@ -16,6 +16,9 @@
 
 #include <tbb/concurrent_hash_map.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace one {
 namespace client {
 namespace cache {
@@ -130,6 +133,47 @@ public:
      */
     bool unsubscribeFileRenamed(const folly::fbstring &fileUuid);
 
+    /**
+     * Adds directory scoped subscriptions for attributes, removal and rename
+     * events of a file. The file is covered by subscriptions of its parent
+     * directory, which are shared by all cached children of the directory.
+     * @param fileUuid UUID of file for which subscriptions are added.
+     * @param parentUuid UUID of the parent directory of the file, if empty
+     * the file is subscribed for directly.
+     */
+    void subscribeDirectoryScoped(
+        const folly::fbstring &fileUuid, const folly::fbstring &parentUuid);
+
+    /**
+     * Cancels directory scoped subscriptions of a file. Subscriptions of the
+     * directory are removed when the last of its cached children is removed.
+     * @param fileUuid UUID of file for which subscriptions are removed.
+     * @return true if subscriptions have been removed, false if they didn't
+     * exist.
+     */
+    bool unsubscribeDirectoryScoped(const folly::fbstring &fileUuid);
+
+    /**
+     * Moves directory scoped subscriptions of a file to its new UUID and
+     * re-scopes the file to its new parent directory.
+     * @param oldUuid Old UUID of the file.
+     * @param newUuid New UUID of the file.
+     * @param newParentUuid UUID of the new parent directory of the file, if
+     * empty the file is subscribed for directly.
+     */
+    void renameDirectoryScoped(const folly::fbstring &oldUuid,
+        const folly::fbstring &newUuid, const folly::fbstring &newParentUuid);
+
+    /**
+     * Sets a callback that will be called after permissions of a file have
+     * changed.
+     * @param cb The callback which takes uuid as parameter.
+     */
+    void onPermissionChanged(std::function<void(const folly::fbstring &)> cb)
+    {
+        m_onPermissionChanged = std::move(cb);
+    }
+
 private:
     void subscribe(const folly::fbstring &fileUuid,
         const events::Subscription &subscription);
@@ -138,6 +182,10 @@ private:
     bool unsubscribe(
         events::StreamKey streamKey, const folly::fbstring &fileUuid);
 
+    // Both require m_directoryScopesMutex to be held
+    void acquireDirectoryScope(const folly::fbstring &scopeUuid);
+    void releaseDirectoryScope(const folly::fbstring &scopeUuid);
+
     void handleFileAttrChanged(events::Events<events::FileAttrChanged> events);
     void handleFileLocationChanged(
         events::Events<events::FileLocationChanged> events);
@@ -150,10 +198,18 @@ private:
     cache::LRUMetadataCache &m_metadataCache;
     cache::ForceProxyIOCache &m_forceProxyIOCache;
     std::function<void(folly::Function<void()>)> m_runInFiber;
+    std::function<void(const folly::fbstring &)> m_onPermissionChanged =
+        [](auto &) {};
     tbb::concurrent_hash_map<Key, std::int64_t, StdHashCompare<Key>>
         m_subscriptions;
 
     using SubscriptionAcc = typename decltype(m_subscriptions)::accessor;
+
+    std::mutex m_directoryScopesMutex;
+    // Maps UUIDs of files to UUIDs of directories covering them
+    std::unordered_map<folly::fbstring, folly::fbstring> m_directoryScopes;
+    // Number of files covered by directory scoped subscriptions
+    std::unordered_map<folly::fbstring, std::size_t> m_directoryScopeRefs;
 };
 
 } // namespace client
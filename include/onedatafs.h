@@ -30,14 +30,18 @@
 #include "options/options.h"
 #include "scheduler.h"
 #include "scopeExit.h"
+#include "util/timingWheel.h"
 #include "version.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/python.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
+#include <folly/ScopeGuard.h>
 #include <fuse.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 using namespace one;
@@ -183,6 +187,73 @@ boost::python::dict toPythonDict(
 
     return dictionary;
 }
+
+/**
+ * Python object exporting the memory of an IOBuf through the buffer
+ * protocol, so that memoryviews over read data don't require a copy.
+ */
+struct PyIOBufObject {
+    // clang-format off
+    PyObject_HEAD
+    folly::IOBuf *buf;
+    // clang-format on
+};
+
+PyBufferProcs pyIOBufBufferProcs = {};
+PyTypeObject pyIOBufType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+void pyIOBufDealloc(PyObject *self)
+{
+    delete reinterpret_cast<PyIOBufObject *>(self)->buf;
+    Py_TYPE(self)->tp_free(self);
+}
+
+int pyIOBufGetBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    auto *buf = reinterpret_cast<PyIOBufObject *>(self)->buf;
+    return PyBuffer_FillInfo(view, self,
+        const_cast<std::uint8_t *>(buf->data()), buf->length(), 1, flags);
+}
+
+void initIOBufType()
+{
+    pyIOBufBufferProcs.bf_getbuffer = pyIOBufGetBuffer;
+
+    pyIOBufType.tp_name = "onedatafs.IOBuf";
+    pyIOBufType.tp_basicsize = sizeof(PyIOBufObject);
+    pyIOBufType.tp_dealloc = pyIOBufDealloc;
+    pyIOBufType.tp_as_buffer = &pyIOBufBufferProcs;
+    pyIOBufType.tp_flags = Py_TPFLAGS_DEFAULT;
+#if PY_MAJOR_VERSION < 3
+    pyIOBufType.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+    pyIOBufType.tp_doc = "Read-only memory of data read from a file.";
+
+    if (PyType_Ready(&pyIOBufType) < 0)
+        throw_error_already_set();
+}
+
+/**
+ * Creates a read-only memoryview over the data in a buffer queue, which is
+ * copied only if it's not contiguous.
+ */
+boost::python::object toMemoryView(folly::IOBufQueue buf)
+{
+    auto iobuf = buf.move();
+    if (!iobuf)
+        iobuf = folly::IOBuf::create(0);
+
+    iobuf->coalesce();
+
+    auto *owner = PyObject_New(PyIOBufObject, &pyIOBufType);
+    if (owner == nullptr)
+        throw_error_already_set();
+
+    owner->buf = iobuf.release();
+    handle<> ownerHandle{reinterpret_cast<PyObject *>(owner)};
+
+    return object{handle<>{PyMemoryView_FromObject(ownerHandle.get())}};
+}
 }
 
 class OnedataFileHandle {
@@ -229,6 +300,79 @@ public:
             .get();
     }
 
+    /**
+     * Reads data into a writable, contiguous buffer, such as a bytearray,
+     * a memoryview or a numpy array, without intermediate copies.
+     * @param buffer The buffer, its size determines the size of the read.
+     * @param offset Offset in the file.
+     * @returns Number of bytes read.
+     */
+    size_t readinto(boost::python::object buffer, const off_t offset)
+    {
+        Py_buffer view;
+        if (PyObject_GetBuffer(buffer.ptr(), &view,
+                PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) != 0)
+            throw_error_already_set();
+
+        // Released after the GIL is reacquired
+        SCOPE_EXIT { PyBuffer_Release(&view); };
+
+        ReleaseGIL guard;
+
+        if (!m_fsLogic)
+            throw one::helpers::makePosixException(EBADF);
+
+        const auto size = static_cast<std::size_t>(view.len);
+        auto buf = m_fiberManager
+                       .addTaskRemoteFuture([this, offset, size]() mutable {
+                           return m_fsLogic->read(
+                               m_uuid, m_fileHandleId, offset, size, {});
+                       })
+                       .get();
+
+        auto iobuf = buf.move();
+        if (!iobuf)
+            return 0;
+
+        auto *target = static_cast<std::uint8_t *>(view.buf);
+        std::size_t copied = 0;
+        for (const auto &range : *iobuf) {
+            const auto length = std::min(range.size(), size - copied);
+            std::memcpy(target + copied, range.data(), length);
+            copied += length;
+        }
+
+        return copied;
+    }
+
+    /**
+     * Reads data, returning a read-only memoryview over the buffers filled
+     * by the storage helper instead of a copy in a new bytes object.
+     * @param offset Offset in the file.
+     * @param size Maximum number of bytes to read.
+     * @returns The memoryview.
+     */
+    boost::python::object readView(const off_t offset, const std::size_t size)
+    {
+        folly::IOBufQueue buf{folly::IOBufQueue::cacheChainLength()};
+
+        {
+            ReleaseGIL guard;
+
+            if (!m_fsLogic)
+                throw one::helpers::makePosixException(EBADF);
+
+            buf = m_fiberManager
+                      .addTaskRemoteFuture([this, offset, size]() mutable {
+                          return m_fsLogic->read(
+                              m_uuid, m_fileHandleId, offset, size, {});
+                      })
+                      .get();
+        }
+
+        return toMemoryView(std::move(buf));
+    }
+
     size_t write(std::string data, const off_t offset)
     {
         ReleaseGIL guard;
@@ -691,6 +835,7 @@ boost::shared_ptr<OnedataFS> makeOnedataFS(std::string host, std::string token,
 
     context->setScheduler(
         std::make_shared<Scheduler>(options->getSchedulerThreadCount()));
+    context->setTimingWheel(std::make_shared<util::TimingWheel>());
 
     auto authManager = getAuthManager(context);
     auto sessionId = generateSessionId();
@@ -767,6 +912,8 @@ BOOST_PYTHON_MODULE(onedatafs)
     PyEval_InitThreads();
     register_exception_translator<std::errc>(&translate);
 
+    initIOBufType();
+
     class_<Stat>("Stat")
         .def_readonly("atime", &Stat::atime)
         .def_readonly("mtime", &Stat::mtime)
@@ -792,6 +939,8 @@ BOOST_PYTHON_MODULE(onedatafs)
         .def("__enter__", &OnedataFileHandle::enter)
         .def("__exit__", &OnedataFileHandle::exit)
         .def("read", &OnedataFileHandle::read)
+        .def("readinto", &OnedataFileHandle::readinto)
+        .def("read_view", &OnedataFileHandle::readView)
         .def("write", &OnedataFileHandle::write)
         .def("flush", &OnedataFileHandle::flush)
         .def("fsync", &OnedataFileHandle::fsync)
@@ -0,0 +1,124 @@
+/**
+ * @file helperHandlePool.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "helperHandlePool.h"
+
+#include "helpers/logging.h"
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace cache {
+
+HelperHandlePool::HelperHandlePool(
+    const std::size_t maxSize, const std::chrono::seconds gracePeriod)
+    : m_maxSize{maxSize}
+    , m_gracePeriod{gracePeriod}
+{
+}
+
+helpers::FileHandlePtr HelperHandlePool::take(const folly::fbstring &storageId,
+    const folly::fbstring &fileId, const int flags)
+{
+    LOG_FCALL() << LOG_FARG(storageId) << LOG_FARG(fileId)
+                << LOG_FARGH(flags);
+
+    prune();
+
+    auto indexIt = m_index.find(std::make_tuple(storageId, fileId, flags));
+    if (indexIt == m_index.end())
+        return {};
+
+    auto entryIt = indexIt->second;
+    auto handle = std::move(entryIt->handle);
+
+    LOG_DBG(2) << "Reusing pooled helper handle to file " << fileId
+               << " on storage " << storageId;
+
+    m_index.erase(indexIt);
+    m_entries.erase(entryIt);
+
+    return handle;
+}
+
+bool HelperHandlePool::put(const folly::fbstring &uuid,
+    const folly::fbstring &storageId, const folly::fbstring &fileId,
+    const int flags, helpers::FileHandlePtr handle)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId)
+                << LOG_FARGH(flags);
+
+    if (!enabled())
+        return false;
+
+    prune();
+
+    if (m_entries.size() >= m_maxSize)
+        evict(m_entries.begin());
+
+    auto key = std::make_tuple(storageId, fileId, flags);
+    m_entries.emplace_back(Entry{uuid, key, std::move(handle),
+        std::chrono::steady_clock::now()});
+    m_index.emplace(std::move(key), std::prev(m_entries.end()));
+
+    return true;
+}
+
+void HelperHandlePool::invalidate(const folly::fbstring &uuid)
+{
+    LOG_FCALL() << LOG_FARG(uuid);
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto current = it++;
+        if (current->uuid == uuid)
+            evict(current);
+    }
+}
+
+bool HelperHandlePool::contains(const folly::fbstring &uuid) const
+{
+    return std::any_of(m_entries.begin(), m_entries.end(),
+        [&](const Entry &entry) { return entry.uuid == uuid; });
+}
+
+void HelperHandlePool::prune()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    while (!m_entries.empty() &&
+        now - m_entries.front().releasedAt >= m_gracePeriod)
+        evict(m_entries.begin());
+}
+
+void HelperHandlePool::clear()
+{
+    while (!m_entries.empty())
+        evict(m_entries.begin());
+}
+
+void HelperHandlePool::evict(std::list<Entry>::iterator it)
+{
+    auto range = m_index.equal_range(it->key);
+    for (auto indexIt = range.first; indexIt != range.second; ++indexIt) {
+        if (indexIt->second == it) {
+            m_index.erase(indexIt);
+            break;
+        }
+    }
+
+    auto uuid = std::move(it->uuid);
+    auto handle = std::move(it->handle);
+    m_entries.erase(it);
+
+    m_onEvict(uuid, std::move(handle));
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
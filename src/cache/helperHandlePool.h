@@ -0,0 +1,142 @@
+/**
+ * @file helperHandlePool.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include "helpers/storageHelper.h"
+
+#include <folly/FBString.h>
+#include <folly/Hash.h>
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <tuple>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c HelperHandlePool keeps helper file handles released by closed files
+ * for a grace period, so that subsequent opens of the same file with the
+ * same flags can reuse them instead of opening the file on the storage
+ * again. The pool is bounded - when full, the least recently released handle
+ * is evicted. Evicted handles are passed to the @c onEvict callback, which
+ * is responsible for releasing them. Only direct IO handles should be pooled,
+ * as proxy IO handles are bound to the Oneprovider handle of the open.
+ *
+ * The pool is not thread-safe and should only be accessed from the fslogic
+ * fiber.
+ */
+class HelperHandlePool {
+public:
+    /**
+     * Constructor.
+     * @param maxSize Maximum number of pooled handles, 0 disables the pool.
+     * @param gracePeriod Time for which released handles are kept.
+     */
+    HelperHandlePool(
+        const std::size_t maxSize, const std::chrono::seconds gracePeriod);
+
+    /**
+     * Takes a pooled handle to a file on a storage, opened with given flags.
+     * @param storageId ID of the storage of the file.
+     * @param fileId ID of the file on the storage.
+     * @param flags Flags with which the handle has been opened.
+     * @returns The pooled handle or nullptr if there is none.
+     */
+    helpers::FileHandlePtr take(const folly::fbstring &storageId,
+        const folly::fbstring &fileId, const int flags);
+
+    /**
+     * Parks a handle released by a closed file in the pool, evicting expired
+     * handles and the least recently released one if the pool is full.
+     * @param uuid Uuid of the file.
+     * @param storageId ID of the storage of the file.
+     * @param fileId ID of the file on the storage.
+     * @param flags Flags with which the handle has been opened.
+     * @param handle The released handle.
+     * @returns false if the pool is disabled and the handle has to be
+     * released by the caller.
+     */
+    bool put(const folly::fbstring &uuid, const folly::fbstring &storageId,
+        const folly::fbstring &fileId, const int flags,
+        helpers::FileHandlePtr handle);
+
+    /**
+     * Evicts all pooled handles of a file.
+     * @param uuid Uuid of the file.
+     */
+    void invalidate(const folly::fbstring &uuid);
+
+    /**
+     * Evicts handles pooled for longer than the grace period.
+     */
+    void prune();
+
+    /**
+     * Evicts all pooled handles.
+     */
+    void clear();
+
+    /**
+     * @returns Number of pooled handles.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @returns true if any handle of a file is pooled.
+     */
+    bool contains(const folly::fbstring &uuid) const;
+
+    /**
+     * @returns true if the pool is enabled.
+     */
+    bool enabled() const { return m_maxSize > 0; }
+
+    /**
+     * Sets a callback that will be called after a handle is evicted from the
+     * pool.
+     * @param cb The callback which takes uuid of the file and the evicted
+     * handle as parameters.
+     */
+    void onEvict(std::function<void(
+            const folly::fbstring &, helpers::FileHandlePtr)>
+            cb)
+    {
+        m_onEvict = std::move(cb);
+    }
+
+private:
+    using Key = std::tuple<folly::fbstring, folly::fbstring, int>;
+
+    struct Entry {
+        folly::fbstring uuid;
+        Key key;
+        helpers::FileHandlePtr handle;
+        std::chrono::steady_clock::time_point releasedAt;
+    };
+
+    void evict(std::list<Entry>::iterator it);
+
+    const std::size_t m_maxSize;
+    const std::chrono::seconds m_gracePeriod;
+
+    // Pooled handles, ordered from the least recently released
+    std::list<Entry> m_entries;
+    std::unordered_multimap<Key, std::list<Entry>::iterator> m_index;
+
+    std::function<void(const folly::fbstring &, helpers::FileHandlePtr)>
+        m_onEvict = [](auto &, auto) {};
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -15,12 +15,16 @@
 #include "messages/fuse/helperParams.h"
 #include "messages/fuse/storageTestFile.h"
 #include "messages/fuse/verifyStorageTestFile.h"
+#include "posixHelper.h"
 
 #include <folly/ThreadName.h>
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <functional>
+#include <sstream>
+#include <vector>
 
 namespace one {
 namespace client {
@@ -69,8 +73,12 @@ HelpersCache::HelpersCache(communication::Communicator &communicator,
     }
 }
 , m_storageAccessManager{m_helperFactory, m_options},
+    m_stateFilePath{options.getStorageAccessStateFilePath()},
+    m_paramsRefreshInterval{options.getHelperParamsRefreshInterval()},
     m_providerTimeout{options.getProviderTimeout()}
 {
+    loadStorageAccessState();
+
     std::generate_n(std::back_inserter(m_helpersWorkers),
         options.getStorageHelperThreadCount(), [this] {
             return std::thread{[this] {
@@ -82,6 +90,13 @@ HelpersCache::HelpersCache(communication::Communicator &communicator,
 
 HelpersCache::~HelpersCache()
 {
+    {
+        std::lock_guard<std::mutex> guard(m_paramsRefreshMutex);
+        for (auto &cancelRefresh : m_cancelParamsRefresh)
+            cancelRefresh.second();
+        m_cancelParamsRefresh.clear();
+    }
+
     m_helpersIoService.stop();
     for (auto &worker : m_helpersWorkers)
         worker.join();
@@ -103,23 +118,84 @@ folly::Future<folly::Unit> HelpersCache::refreshHelperParameters(
 {
     LOG_FCALL() << LOG_FARG(storageId) << LOG_FARG(spaceId);
 
-    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    auto refreshKey = std::make_tuple(storageId, spaceId);
+    auto promise = std::make_shared<folly::SharedPromise<folly::Unit>>();
 
-    // Get the helper promise if exists already
-    auto helperKey = std::make_pair(storageId, false);
-    auto helperPromiseIt = m_cache.find(helperKey);
+    {
+        std::lock_guard<std::mutex> guard(m_paramsRefreshMutex);
+
+        // Join the refresh already in progress, so that all operations
+        // which failed due to expired credentials wait for one request
+        auto refreshIt = m_paramsRefreshes.find(refreshKey);
+        if (refreshIt != m_paramsRefreshes.end()) {
+            LOG_DBG(2) << "Waiting for pending refresh of helper parameters "
+                          "for storage "
+                       << storageId << " in space " << spaceId;
+            return refreshIt->second->getFuture();
+        }
 
-    if (helperPromiseIt == m_cache.end()) {
-        LOG(WARNING) << "Trying to refresh parameters for nonexisting helper "
-                        "to storage: "
-                     << storageId;
-        return folly::makeFuture();
+        // Operations which failed with credentials replaced in the meantime
+        // can be retried right away
+        auto lastRefreshIt = m_lastParamsRefresh.find(refreshKey);
+        if (lastRefreshIt != m_lastParamsRefresh.end() &&
+            std::chrono::steady_clock::now() - lastRefreshIt->second <
+                HELPER_PARAMS_REFRESH_COALESCE_WINDOW) {
+            LOG_DBG(2) << "Helper parameters for storage " << storageId
+                       << " in space " << spaceId << " have just been "
+                       << "refreshed";
+            return folly::makeFuture();
+        }
+
+        m_paramsRefreshes.emplace(refreshKey, promise);
+    }
+
+    fetchHelperParameters(storageId, spaceId)
+        .then([this, refreshKey, promise](folly::Try<folly::Unit> result) {
+            {
+                std::lock_guard<std::mutex> guard(m_paramsRefreshMutex);
+                m_paramsRefreshes.erase(refreshKey);
+                if (result.hasValue())
+                    m_lastParamsRefresh[refreshKey] =
+                        std::chrono::steady_clock::now();
+            }
+
+            promise->setTry(std::move(result));
+        });
+
+    return promise->getFuture();
+}
+
+folly::Future<folly::Unit> HelpersCache::fetchHelperParameters(
+    const folly::fbstring &storageId, const folly::fbstring &spaceId)
+{
+    LOG_FCALL() << LOG_FARG(storageId) << LOG_FARG(spaceId);
+
+    std::shared_ptr<folly::SharedPromise<HelperPtr>> helperPromise;
+
+    {
+        std::lock_guard<std::mutex> guard(m_cacheMutex);
+
+        // Get the helper promise if exists already
+        auto helperKey = std::make_pair(storageId, false);
+        auto helperPromiseIt = m_cache.find(helperKey);
+
+        if (helperPromiseIt == m_cache.end()) {
+            LOG(WARNING)
+                << "Trying to refresh parameters for nonexisting helper "
+                   "to storage: "
+                << storageId;
+            return folly::makeFuture();
+        }
+
+        helperPromise = helperPromiseIt->second;
     }
 
     // Invalidate helper parameters and obtain a new parameters promise
-    return helperPromiseIt->second->getFuture().then([this, storageId, spaceId](
-                                                         HelpersCache::HelperPtr
-                                                             helper) {
+    return helperPromise->getFuture().then([this, storageId, spaceId](
+                                               HelpersCache::HelperPtr helper) {
+        LOG_DBG(1) << "Refreshing helper parameters for storage "
+                   << storageId << " in space " << spaceId;
+
         auto params = communication::wait(
             m_communicator.communicate<messages::fuse::HelperParams>(
                 messages::fuse::GetHelperParams{storageId.toStdString(),
@@ -140,6 +216,66 @@ folly::Future<folly::Unit> HelpersCache::refreshHelperParameters(
     });
 }
 
+void HelpersCache::scheduleHelperParamsRefresh(
+    const folly::fbstring &storageId, const folly::fbstring &spaceId,
+    const std::chrono::seconds after)
+{
+    if (m_paramsRefreshInterval.count() == 0)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_paramsRefreshMutex);
+
+    auto refreshKey = std::make_tuple(storageId, spaceId);
+    if (m_cancelParamsRefresh.find(refreshKey) != m_cancelParamsRefresh.end())
+        return;
+
+    LOG_DBG(1) << "Scheduling next refresh of helper parameters for storage "
+               << storageId << " in space " << spaceId << " in "
+               << after.count() << " seconds";
+
+    m_cancelParamsRefresh.emplace(refreshKey,
+        m_scheduler.schedule(after, [this, storageId, spaceId] {
+            refreshHelperParamsProactively(storageId, spaceId);
+        }));
+}
+
+void HelpersCache::refreshHelperParamsProactively(
+    const folly::fbstring &storageId, const folly::fbstring &spaceId)
+{
+    LOG_FCALL() << LOG_FARG(storageId) << LOG_FARG(spaceId);
+
+    {
+        std::lock_guard<std::mutex> guard(m_paramsRefreshMutex);
+        m_cancelParamsRefresh.erase(std::make_tuple(storageId, spaceId));
+    }
+
+    // Proxy IO helpers don't use storage credentials, the refresh will be
+    // scheduled again if the storage becomes directly accessible
+    const auto accessType = getAccessType(storageId);
+    if (accessType == AccessType::PROXY)
+        return;
+
+    if (accessType == AccessType::UNKNOWN) {
+        scheduleHelperParamsRefresh(
+            storageId, spaceId, m_paramsRefreshInterval);
+        return;
+    }
+
+    refreshHelperParameters(storageId, spaceId)
+        .then([this, storageId, spaceId] {
+            scheduleHelperParamsRefresh(
+                storageId, spaceId, m_paramsRefreshInterval);
+        })
+        .onError([this, storageId, spaceId](const std::exception &e) {
+            LOG(WARNING) << "Refreshing helper parameters for storage "
+                         << storageId << " failed with error: " << e.what();
+
+            scheduleHelperParamsRefresh(storageId, spaceId,
+                std::min(m_paramsRefreshInterval,
+                    FAILED_HELPER_PARAMS_REFRESH_RETRY));
+        });
+}
+
 folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
     const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
     const folly::fbstring &storageId, bool forceProxyIO)
@@ -157,6 +293,9 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
     }
 
     if (m_options.isDirectIOForced()) {
+        scheduleHelperParamsRefresh(
+            storageId, spaceId, m_paramsRefreshInterval);
+
         auto helperKey = std::make_pair(storageId, false);
         auto helperPromiseIt = m_cache.find(helperKey);
 
@@ -172,7 +311,7 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
             m_cache.emplace(std::make_tuple(storageId, false), p);
 
             m_scheduler.post(
-                [ this, &fileUuid, &spaceId, &storageId, p = std::move(p) ] {
+                [ this, fileUuid, spaceId, storageId, p = std::move(p) ] {
                     p->setWith([=] {
                         return performForcedDirectIOStorageDetection(
                             fileUuid, spaceId, storageId);
@@ -185,6 +324,10 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
 
     forceProxyIO |= m_options.isProxyIOForced();
 
+    if (!forceProxyIO)
+        scheduleHelperParamsRefresh(
+            storageId, spaceId, m_paramsRefreshInterval);
+
     auto helperKey = std::make_pair(storageId, forceProxyIO);
 
     std::lock_guard<std::mutex> guard(m_cacheMutex);
@@ -199,8 +342,7 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
         m_cache.emplace(std::make_tuple(storageId, forceProxyIO), p);
 
         m_scheduler.post([
-            this, &fileUuid, &spaceId, &storageId, forceProxyIO,
-            p = std::move(p)
+            this, fileUuid, spaceId, storageId, forceProxyIO, p = std::move(p)
         ] {
             p->setWith([=] {
                 return performAutoIOStorageDetection(
@@ -234,6 +376,26 @@ HelpersCache::HelperPtr HelpersCache::performAutoIOStorageDetection(
 
     if (!forceProxyIO) {
         if (accessUnset) {
+            // Reuse the access type detected during previous mount, if
+            // persisted, and verify it in background
+            auto persistedAccessType = takePersistedAccessType(storageId);
+            if (persistedAccessType == AccessType::DIRECT) {
+                auto helper =
+                    reusePersistedDirectIOHelper(fileUuid, spaceId, storageId);
+                if (helper)
+                    return helper;
+            }
+            else if (persistedAccessType == AccessType::PROXY) {
+                LOG_DBG(2) << "Storage " << storageId
+                           << " was accessed through proxy during previous "
+                              "mount - verifying direct access in background";
+                m_scheduler.post([this, fileUuid, storageId] {
+                    requestStorageTestFileCreation(fileUuid, storageId);
+                });
+                return performAutoIOStorageDetection(
+                    fileUuid, spaceId, storageId, true);
+            }
+
             // First try to quickly detect direct io (in 1 attempt), if not
             // available, return proxy and schedule full storage detection
             auto helper =
@@ -351,6 +513,196 @@ HelpersCache::HelperPtr HelpersCache::performForcedDirectIOStorageDetection(
     }
 }
 
+HelpersCache::HelperPtr HelpersCache::reusePersistedDirectIOHelper(
+    const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
+    const folly::fbstring &storageId)
+{
+    LOG_DBG(1) << "Reusing direct access to storage " << storageId
+               << " detected during previous mount";
+
+    HelperPtr helper;
+
+    try {
+        auto mountPoint = m_storageAccessManager.mountPoint(storageId);
+        if (mountPoint) {
+            helper = m_helperFactory.getStorageHelper(
+                helpers::POSIX_HELPER_NAME,
+                {{helpers::POSIX_HELPER_MOUNT_POINT_ARG, mountPoint->string()}},
+                m_options.isIOBuffered());
+        }
+        else {
+            auto params = communication::wait(
+                m_communicator.communicate<messages::fuse::HelperParams>(
+                    messages::fuse::GetHelperParams{storageId.toStdString(),
+                        spaceId.toStdString(),
+                        messages::fuse::GetHelperParams::HelperMode::
+                            directMode}),
+                m_providerTimeout);
+
+            // POSIX storages can only be reused with a known mountpoint
+            if (params.name() == helpers::PROXY_HELPER_NAME ||
+                params.name() == helpers::POSIX_HELPER_NAME)
+                return {};
+
+            std::unordered_map<folly::fbstring, folly::fbstring> overrideParams;
+            if (m_helperParamOverrides.find(storageId) !=
+                m_helperParamOverrides.end())
+                overrideParams = m_helperParamOverrides.at(storageId);
+
+            helper = m_helperFactory.getStorageHelper(params.name(),
+                params.args(), m_options.isIOBuffered(), overrideParams);
+        }
+    }
+    catch (const std::exception &e) {
+        LOG(WARNING) << "Cannot reuse direct access to storage " << storageId
+                     << ": " << e.what();
+        return {};
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+        m_accessType[storageId] = AccessType::DIRECT;
+    }
+
+    // On failed verification, either local or by the provider, drop the
+    // helper, so that the storage is accessed through proxy or detected
+    // again on next request
+    m_scheduler.post([this, fileUuid, storageId] {
+        const bool verified =
+            requestStorageTestFileCreation(fileUuid, storageId) &&
+            getAccessType(storageId) == AccessType::DIRECT;
+        if (verified)
+            return;
+
+        LOG(WARNING) << "Direct access to storage " << storageId
+                     << " detected during previous mount is no longer valid";
+
+        {
+            std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+            auto it = m_accessType.find(storageId);
+            if (it != m_accessType.end() && it->second == AccessType::DIRECT)
+                m_accessType.erase(it);
+        }
+
+        std::lock_guard<std::mutex> guard(m_cacheMutex);
+        m_cache.erase(std::make_tuple(storageId, false));
+    });
+
+    return helper;
+}
+
+folly::Optional<HelpersCache::AccessType>
+HelpersCache::takePersistedAccessType(const folly::fbstring &storageId)
+{
+    std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+
+    auto it = m_persistedAccessType.find(storageId);
+    if (it == m_persistedAccessType.end())
+        return {};
+
+    auto accessType = it->second;
+    m_persistedAccessType.erase(it);
+    return accessType;
+}
+
+void HelpersCache::recordAccessType(
+    const folly::fbstring &storageId, const AccessType accessType)
+{
+    m_accessType[storageId] = accessType;
+    m_detectedAccessType[storageId] = accessType;
+}
+
+void HelpersCache::loadStorageAccessState()
+{
+    if (!m_stateFilePath)
+        return;
+
+    std::ifstream stateFile{m_stateFilePath->string()};
+    if (!stateFile) {
+        LOG_DBG(1) << "Storage access state file " << *m_stateFilePath
+                   << " doesn't exist yet";
+        return;
+    }
+
+    // Each line contains storage id, access type and an optional mountpoint
+    std::string line;
+    while (std::getline(stateFile, line)) {
+        std::istringstream fields{line};
+        std::string storageId;
+        std::string accessType;
+        std::string mountPoint;
+
+        if (!(fields >> storageId >> accessType))
+            continue;
+
+        std::getline(fields >> std::ws, mountPoint);
+
+        if (accessType == "direct")
+            m_persistedAccessType[storageId] = AccessType::DIRECT;
+        else if (accessType == "proxy")
+            m_persistedAccessType[storageId] = AccessType::PROXY;
+        else
+            continue;
+
+        if (!mountPoint.empty())
+            m_storageAccessManager.setMountPoint(storageId, mountPoint);
+    }
+
+    LOG(INFO) << "Loaded access types of " << m_persistedAccessType.size()
+              << " storages from " << *m_stateFilePath;
+}
+
+void HelpersCache::saveStorageAccessState()
+{
+    if (!m_stateFilePath)
+        return;
+
+    // Serializes writers, so that a newer snapshot is never overwritten by
+    // an older one, without blocking lookups of the access types
+    std::lock_guard<std::mutex> stateFileGuard(m_stateFileMutex);
+
+    // Keep the storages which haven't been accessed during this mount
+    std::vector<std::pair<folly::fbstring, AccessType>> accessTypes;
+    {
+        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+        accessTypes.assign(
+            m_persistedAccessType.begin(), m_persistedAccessType.end());
+        accessTypes.insert(accessTypes.end(), m_detectedAccessType.begin(),
+            m_detectedAccessType.end());
+    }
+
+    const auto tmpPath = m_stateFilePath->string() + ".tmp";
+
+    {
+        std::ofstream stateFile{tmpPath, std::ios::trunc};
+
+        for (const auto &accessType : accessTypes) {
+            stateFile << accessType.first << " "
+                      << (accessType.second == AccessType::DIRECT ? "direct"
+                                                                  : "proxy");
+
+            auto mountPoint =
+                m_storageAccessManager.mountPoint(accessType.first);
+            if (accessType.second == AccessType::DIRECT && mountPoint)
+                stateFile << " " << mountPoint->string();
+
+            stateFile << "\n";
+        }
+
+        if (!stateFile) {
+            LOG(WARNING) << "Cannot write storage access state file "
+                         << tmpPath;
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpPath, *m_stateFilePath, ec);
+    if (ec)
+        LOG(WARNING) << "Cannot replace storage access state file "
+                     << *m_stateFilePath << ": " << ec.message();
+}
+
 HelpersCache::HelperPtr HelpersCache::requestStorageTestFileCreation(
     const folly::fbstring &fileUuid, const folly::fbstring &storageId,
     const int maxAttempts)
@@ -410,8 +762,12 @@ HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
                          "file verification attempts limit ("
                       << maxAttempts << ") exceeded.";
 
-            std::lock_guard<std::mutex> guard(m_accessTypeMutex);
-            m_accessType[storageId] = AccessType::PROXY;
+            {
+                std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+                recordAccessType(storageId, AccessType::PROXY);
+            }
+
+            saveStorageAccessState();
             return {};
         }
 
@@ -426,18 +782,21 @@ HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
         LOG(ERROR) << "Storage test file handling error, code: '" << e.code()
                    << "', message: '" << e.what() << "'";
 
-        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
-
         if (e.code().value() == EAGAIN) {
+            std::lock_guard<std::mutex> guard(m_accessTypeMutex);
             m_accessType.erase(storageId);
+            return {};
         }
-        else {
-            LOG(INFO) << "Storage '" << storageId
-                      << "' is not directly accessible to the client.";
 
-            m_accessType[storageId] = AccessType::PROXY;
+        LOG(INFO) << "Storage '" << storageId
+                  << "' is not directly accessible to the client.";
+
+        {
+            std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+            recordAccessType(storageId, AccessType::PROXY);
         }
 
+        saveStorageAccessState();
         return {};
     }
 }
@@ -466,7 +825,7 @@ void HelpersCache::requestStorageTestFileVerification(
         handleStorageTestFileVerification({}, storageId);
     }
     catch (const std::system_error &e) {
-        handleStorageTestFileVerification(e.code(), {});
+        handleStorageTestFileVerification(e.code(), storageId);
     }
 }
 
@@ -476,28 +835,37 @@ void HelpersCache::handleStorageTestFileVerification(
     LOG_DBG(1) << "Handling verification of storage direct access: "
                << storageId;
 
-    std::lock_guard<std::mutex> guard(m_accessTypeMutex);
-
     if (!ec) {
         LOG(INFO) << "Storage " << storageId
                   << " is directly accessible to the client.";
 
-        m_accessType[storageId] = AccessType::DIRECT;
+        {
+            std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+            recordAccessType(storageId, AccessType::DIRECT);
+        }
+
+        saveStorageAccessState();
+        return;
     }
-    else {
-        LOG(ERROR) << "Storage test file verification error, code: '"
-                   << ec.value() << "', message: '" << ec.message() << "'";
 
-        if (ec.value() == EAGAIN) {
-            m_accessType.erase(storageId);
-        }
-        else {
-            LOG(INFO) << "Storage '" << storageId
-                      << "' is not directly accessible to the client.";
+    LOG(ERROR) << "Storage test file verification error, code: '"
+               << ec.value() << "', message: '" << ec.message() << "'";
 
-            m_accessType[storageId] = AccessType::PROXY;
-        }
+    if (ec.value() == EAGAIN) {
+        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+        m_accessType.erase(storageId);
+        return;
+    }
+
+    LOG(INFO) << "Storage '" << storageId
+              << "' is not directly accessible to the client.";
+
+    {
+        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
+        recordAccessType(storageId, AccessType::PROXY);
     }
+
+    saveStorageAccessState();
 }
 
 } // namespace cache
@@ -23,8 +23,11 @@
 #include <folly/Hash.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
+#include <folly/Optional.h>
 #include <folly/futures/SharedPromise.h>
 
+#include <chrono>
+#include <functional>
 #include <thread>
 #include <tuple>
 #include <utility>
@@ -43,6 +46,8 @@ namespace cache {
 
 constexpr unsigned int VERIFY_TEST_FILE_ATTEMPTS = 5;
 constexpr std::chrono::seconds VERIFY_TEST_FILE_DELAY{5};
+constexpr std::chrono::seconds HELPER_PARAMS_REFRESH_COALESCE_WINDOW{2};
+constexpr std::chrono::seconds FAILED_HELPER_PARAMS_REFRESH_RETRY{10};
 
 /**
  * @c HelpersCache is responsible for creating and caching
@@ -93,10 +98,32 @@ public:
     virtual HelpersCache::AccessType getAccessType(
         const folly::fbstring &storageId);
 
+    /**
+     * Refreshes parameters of a direct IO helper, e.g. after its credentials
+     * expired. Concurrent refreshes for the same storage and space are
+     * coalesced into a single request to Oneprovider, and refreshes
+     * requested shortly after a successful one complete immediately.
+     * @param storageId Storage id of the helper.
+     * @param spaceId Space id in the context of which parameters are fetched.
+     * @return Future fulfilled when the parameters have been refreshed.
+     */
     folly::Future<folly::Unit> refreshHelperParameters(
         const folly::fbstring &storageId, const folly::fbstring &spaceId);
 
 private:
+    folly::Future<folly::Unit> fetchHelperParameters(
+        const folly::fbstring &storageId, const folly::fbstring &spaceId);
+
+    /**
+     * Schedules proactive refresh of helper parameters, unless it has been
+     * already scheduled for the storage and space or it is disabled.
+     */
+    void scheduleHelperParamsRefresh(const folly::fbstring &storageId,
+        const folly::fbstring &spaceId, const std::chrono::seconds after);
+
+    void refreshHelperParamsProactively(
+        const folly::fbstring &storageId, const folly::fbstring &spaceId);
+
     HelpersCache::HelperPtr requestStorageTestFileCreation(
         const folly::fbstring &fileUuid, const folly::fbstring &storageId,
         const int maxAttempts = VERIFY_TEST_FILE_ATTEMPTS);
@@ -121,6 +148,39 @@ private:
         const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
         const folly::fbstring &storageId);
 
+    /**
+     * Creates a direct IO helper for a storage detected as directly
+     * accessible during previous mount, and schedules its verification.
+     * @return The helper or nullptr if it can't be created.
+     */
+    HelpersCache::HelperPtr reusePersistedDirectIOHelper(
+        const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
+        const folly::fbstring &storageId);
+
+    /**
+     * Takes the access type of a storage loaded from the state file, so that
+     * it is reused only for the first detection after mount.
+     */
+    folly::Optional<AccessType> takePersistedAccessType(
+        const folly::fbstring &storageId);
+
+    /**
+     * Sets the detected access type of a storage. Must be called with
+     * @c m_accessTypeMutex held, the access types are then persisted with
+     * @c saveStorageAccessState after releasing it.
+     */
+    void recordAccessType(
+        const folly::fbstring &storageId, const AccessType accessType);
+
+    void loadStorageAccessState();
+
+    /**
+     * Writes the access types to the state file, if enabled. Must be called
+     * without @c m_accessTypeMutex held, as the file is written outside of
+     * it.
+     */
+    void saveStorageAccessState();
+
     communication::Communicator &m_communicator;
     Scheduler &m_scheduler;
     const options::Options &m_options;
@@ -148,6 +208,13 @@ private:
     std::unordered_map<folly::fbstring, AccessType> m_accessType;
     std::mutex m_accessTypeMutex;
 
+    // Access types determined by storage detection, persisted in the state
+    // file, and the ones loaded from it on mount
+    const boost::optional<boost::filesystem::path> m_stateFilePath;
+    std::unordered_map<folly::fbstring, AccessType> m_detectedAccessType;
+    std::unordered_map<folly::fbstring, AccessType> m_persistedAccessType;
+    std::mutex m_stateFileMutex;
+
     // Helpers are stored in a map where keys are defined using 2 values:
     //  - storageId of the storage
     //  - forceProxyIO flag
@@ -162,6 +229,25 @@ private:
         m_cache;
     std::mutex m_cacheMutex;
 
+    // Helper parameters refreshes are keyed by storageId and spaceId
+    using HelperParamsRefreshKey = std::tuple<folly::fbstring, folly::fbstring>;
+
+    // Pending helper parameters refreshes, awaited by all operations which
+    // failed due to expired credentials, times of last successful refreshes
+    // and cancel handles of scheduled proactive refreshes
+    std::unordered_map<HelperParamsRefreshKey,
+        std::shared_ptr<folly::SharedPromise<folly::Unit>>>
+        m_paramsRefreshes;
+    std::unordered_map<HelperParamsRefreshKey,
+        std::chrono::steady_clock::time_point>
+        m_lastParamsRefresh;
+    std::unordered_map<HelperParamsRefreshKey, std::function<void()>>
+        m_cancelParamsRefresh;
+    std::mutex m_paramsRefreshMutex;
+
+    // Interval of proactive helper parameters refresh, 0 if disabled
+    const std::chrono::seconds m_paramsRefreshInterval;
+
     // Timeout for Oneprovider responses
     std::chrono::milliseconds m_providerTimeout;
 };
@@ -10,7 +10,10 @@
 #include "helpers/logging.h"
 #include "monitoring/monitoring.h"
 
+#include <folly/Hash.h>
+
 #include <cassert>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -18,17 +21,25 @@ namespace one {
 namespace client {
 namespace cache {
 
-InodeCache::Entry::Entry(const fuse_ino_t inode_, folly::fbstring uuid_)
-    : inode{inode_}
-    , uuid{std::move(uuid_)}
-{
-}
-
-InodeCache::InodeCache(
-    folly::fbstring rootUuid, const std::size_t targetCacheSize)
+namespace {
+constexpr std::uint32_t EMPTY_SLOT = 0;
+constexpr std::uint32_t TOMBSTONE_SLOT =
+    std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+constexpr std::size_t MIN_INDEX_SIZE = 16;
+// Pruning evicts entries until the cache is smaller than its target size by
+// 1/PRUNE_BATCH_DIVISOR, so that it does not run on every lookup
+constexpr std::size_t PRUNE_BATCH_DIVISOR = 16;
+} // namespace
+
+InodeCache::InodeCache(folly::fbstring rootUuid,
+    const std::size_t targetCacheSize, const bool deterministicInodes)
     : m_targetCacheSize{targetCacheSize}
+    , m_deterministicInodes{deterministicInodes}
 {
-    m_cache.emplace(FUSE_ROOT_ID, rootUuid);
+    auto root = emplace(FUSE_ROOT_ID, std::move(rootUuid));
+    m_entries[root].lookupCount = 1;
+
     ONE_METRIC_COUNTER_SET(
         "comp.oneclient.mod.inodecache.maxsize", targetCacheSize);
 }
@@ -37,33 +48,25 @@ fuse_ino_t InodeCache::lookup(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    auto entryIt = index.find(uuid);
+    auto entryPos = findByUuid(uuid);
+    if (entryPos != NOT_FOUND) {
+        auto &entry = m_entries[entryPos];
+        if (entry.lookupCount++ == 0)
+            unlinkEvictable(entryPos);
 
-    if (entryIt != index.end()) {
-        if (entryIt->lruIt) {
-            m_lru.erase(*entryIt->lruIt);
-            index.modify(entryIt, [](Entry &entry) {
-                entry.lruIt.clear();
-                ++entry.lookupCount;
-            });
-        }
-        else
-            index.modify(entryIt, [](Entry &e) { ++e.lookupCount; });
+        LOG_DBG(2) << "Found inode " << entry.inode << " for file " << uuid;
 
-        LOG_DBG(2) << "Found inode " << entryIt->inode << " for file " << uuid;
-
-        return entryIt->inode;
+        return entry.inode;
     }
 
-    const auto inode = m_nextInode++;
-    m_cache.emplace(inode, uuid);
+    const auto inode = allocateInode(uuid);
+    m_entries[emplace(inode, uuid)].lookupCount = 1;
 
     LOG_DBG(2) << "Created new inode " << inode << " for file " << uuid;
 
     prune();
 
-    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.inodecache.size", index.size());
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.inodecache.size", m_size);
 
     return inode;
 }
@@ -72,83 +75,318 @@ folly::fbstring InodeCache::at(const fuse_ino_t inode) const
 {
     LOG_FCALL() << LOG_FARG(inode);
 
-    auto &index = boost::multi_index::get<ByInode>(m_cache);
-    auto entryIt = index.find(inode);
-    if (entryIt == index.end() || entryIt->lruIt) {
+    auto entryPos = findByInode(inode);
+    if (entryPos == NOT_FOUND || m_entries[entryPos].lookupCount == 0) {
         LOG(ERROR) << "No file found for inode " << inode;
         throw std::out_of_range{
             "no active mapping for inode " + std::to_string(inode)};
     }
 
-    LOG_DBG(2) << "Returning file " << entryIt->uuid << " for inode " << inode;
+    const auto &uuid = m_entries[entryPos].uuid;
+
+    LOG_DBG(2) << "Returning file " << uuid << " for inode " << inode;
 
-    return entryIt->uuid;
+    return uuid;
 }
 
 void InodeCache::forget(const fuse_ino_t inode, const std::size_t count)
 {
     LOG_FCALL() << LOG_FARG(inode) << LOG_FARG(count);
 
-    auto &index = boost::multi_index::get<ByInode>(m_cache);
-    auto entryIt = index.find(inode);
+    auto entryPos = findByInode(inode);
 
-    assert(entryIt != index.end());
-    assert(entryIt->lookupCount >= count);
+    assert(entryPos != NOT_FOUND);
+    auto &entry = m_entries[entryPos];
+    assert(entry.lookupCount >= count);
 
-    const auto newCount = entryIt->lookupCount - count;
+    const auto newCount = entry.lookupCount - count;
 
     if (newCount > 0) {
         LOG_DBG(2) << "Changing inode " << inode << " lookup count to "
                    << newCount;
-        index.modify(entryIt, [&](Entry &e) { e.lookupCount = newCount; });
+        entry.lookupCount = newCount;
     }
-    else if (entryIt->deleted) {
+    else if (entry.deleted) {
         LOG_DBG(2) << "Removing deleted inode " << inode << " from inode cache";
-        index.erase(entryIt);
+        erase(entryPos);
     }
     else {
-        LOG_DBG(2) << "Modifying entry lookup count to " << newCount
-                   << " and lru index";
-        const auto newLruIt = m_lru.insert(m_lru.end(), inode);
-        index.modify(entryIt, [&](Entry &entry) {
-            entry.lookupCount = newCount;
-            entry.lruIt = newLruIt;
-        });
+        LOG_DBG(2) << "Marking inode " << inode << " as evictable";
+        entry.lookupCount = 0;
+        linkEvictable(entryPos);
 
         prune();
     }
-    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.inodecache.size", index.size());
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.inodecache.size", m_size);
 }
 
 void InodeCache::rename(folly::fbstring oldUuid, folly::fbstring newUuid)
 {
     LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid);
 
-    auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    const auto entryRange = index.equal_range(oldUuid);
-    for (auto it = entryRange.first; it != entryRange.second; ++it)
-        index.modify_key(it, [&](folly::fbstring &key) { key.swap(newUuid); });
+    if (oldUuid == newUuid)
+        return;
+
+    const auto slot = findSlot(m_byUuid, hashUuid(oldUuid),
+        [&](std::uint32_t entry) { return m_entries[entry].uuid == oldUuid; });
+    if (slot == NOT_FOUND)
+        return;
+
+    const auto entryPos = m_byUuid.slots[slot] - 1;
+
+    // Keep uuids unique, as the previous ordered index did, by dropping the
+    // renamed entry if the new uuid is already known
+    if (findByUuid(newUuid) != NOT_FOUND) {
+        erase(entryPos);
+        return;
+    }
+
+    eraseSlot(m_byUuid, slot);
+    m_entries[entryPos].uuid.swap(newUuid);
+    insertSlot(m_byUuid, hashUuid(m_entries[entryPos].uuid), entryPos,
+        [this](std::uint32_t e) { return hashUuid(m_entries[e].uuid); });
 }
 
 void InodeCache::markDeleted(folly::fbstring uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    const auto entryRange = index.equal_range(uuid);
-    for (auto it = entryRange.first; it != entryRange.second; ++it)
-        index.modify(it, [](Entry &e) { e.deleted = true; });
+    auto entryPos = findByUuid(uuid);
+    if (entryPos != NOT_FOUND)
+        m_entries[entryPos].deleted = true;
+}
+
+std::size_t InodeCache::hashInode(const fuse_ino_t inode)
+{
+    return folly::hash::twang_mix64(inode);
+}
+
+std::size_t InodeCache::hashUuid(const folly::fbstring &uuid)
+{
+    return std::hash<folly::fbstring>{}(uuid);
+}
+
+std::size_t InodeCache::findByInode(const fuse_ino_t inode) const
+{
+    auto slot = findSlot(m_byInode, hashInode(inode),
+        [&](std::uint32_t entry) { return m_entries[entry].inode == inode; });
+
+    return slot == NOT_FOUND ? NOT_FOUND : m_byInode.slots[slot] - 1;
+}
+
+std::size_t InodeCache::findByUuid(const folly::fbstring &uuid) const
+{
+    auto slot = findSlot(m_byUuid, hashUuid(uuid),
+        [&](std::uint32_t entry) { return m_entries[entry].uuid == uuid; });
+
+    return slot == NOT_FOUND ? NOT_FOUND : m_byUuid.slots[slot] - 1;
+}
+
+template <typename Equals>
+std::size_t InodeCache::findSlot(
+    const Index &index, std::size_t hash, Equals &&equals) const
+{
+    if (index.slots.empty())
+        return NOT_FOUND;
+
+    // The index always has an empty slot, so the probing terminates
+    const auto mask = index.slots.size() - 1;
+    for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+        const auto value = index.slots[slot];
+        if (value == EMPTY_SLOT)
+            return NOT_FOUND;
+        if (value != TOMBSTONE_SLOT && equals(value - 1))
+            return slot;
+    }
+}
+
+template <typename Hash>
+void InodeCache::insertSlot(
+    Index &index, std::size_t hash, std::uint32_t entry, Hash &&entryHash)
+{
+    // Keep the load factor, including tombstones, below 3/4
+    if (4 * (index.used + index.tombstones + 1) > 3 * index.slots.size())
+        rehash(index, entryHash);
+
+    const auto mask = index.slots.size() - 1;
+    auto slot = hash & mask;
+    while (index.slots[slot] != EMPTY_SLOT &&
+        index.slots[slot] != TOMBSTONE_SLOT)
+        slot = (slot + 1) & mask;
+
+    if (index.slots[slot] == TOMBSTONE_SLOT)
+        --index.tombstones;
+
+    index.slots[slot] = entry + 1;
+    ++index.used;
+}
+
+void InodeCache::eraseSlot(Index &index, std::size_t slot)
+{
+    index.slots[slot] = TOMBSTONE_SLOT;
+    --index.used;
+    ++index.tombstones;
+}
+
+template <typename Hash> void InodeCache::rehash(Index &index, Hash &&entryHash)
+{
+    // Grow only if live entries fill the index, otherwise just drop tombstones
+    auto size = std::max(MIN_INDEX_SIZE, index.slots.size());
+    while (2 * (index.used + 1) > size)
+        size *= 2;
+
+    std::vector<std::uint32_t> slots(size, EMPTY_SLOT);
+    const auto mask = size - 1;
+    for (const auto value : index.slots) {
+        if (value == EMPTY_SLOT || value == TOMBSTONE_SLOT)
+            continue;
+
+        auto slot = entryHash(value - 1) & mask;
+        while (slots[slot] != EMPTY_SLOT)
+            slot = (slot + 1) & mask;
+        slots[slot] = value;
+    }
+
+    index.slots.swap(slots);
+    index.tombstones = 0;
+}
+
+std::uint32_t InodeCache::emplace(fuse_ino_t inode, folly::fbstring uuid)
+{
+    std::uint32_t entryPos;
+    if (!m_freeEntries.empty()) {
+        entryPos = m_freeEntries.back();
+        m_freeEntries.pop_back();
+    }
+    else {
+        entryPos = m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    auto &entry = m_entries[entryPos];
+    entry.inode = inode;
+    entry.uuid = std::move(uuid);
+    entry.lookupCount = 0;
+    entry.used = true;
+    entry.deleted = false;
+    entry.referenced = false;
+
+    insertSlot(m_byInode, hashInode(inode), entryPos,
+        [this](std::uint32_t e) { return hashInode(m_entries[e].inode); });
+    insertSlot(m_byUuid, hashUuid(entry.uuid), entryPos,
+        [this](std::uint32_t e) { return hashUuid(m_entries[e].uuid); });
+
+    ++m_size;
+
+    return entryPos;
+}
+
+void InodeCache::erase(std::uint32_t entryPos)
+{
+    auto &entry = m_entries[entryPos];
+
+    eraseSlot(m_byInode,
+        findSlot(m_byInode, hashInode(entry.inode),
+            [&](std::uint32_t e) { return e == entryPos; }));
+    eraseSlot(m_byUuid,
+        findSlot(m_byUuid, hashUuid(entry.uuid),
+            [&](std::uint32_t e) { return e == entryPos; }));
+
+    if (entry.lookupCount == 0)
+        unlinkEvictable(entryPos);
+
+    entry.used = false;
+    folly::fbstring{}.swap(entry.uuid);
+    m_freeEntries.emplace_back(entryPos);
+    --m_size;
+}
+
+std::uint64_t InodeCache::generation(const folly::fbstring &uuid)
+{
+    const auto generation = folly::hash::twang_mix64(
+        folly::hash::fnv64_buf(uuid.data(), uuid.size()));
+
+    return generation != 0 ? generation : 1;
+}
+
+fuse_ino_t InodeCache::allocateInode(const folly::fbstring &uuid)
+{
+    if (!m_deterministicInodes)
+        return m_nextInode++;
+
+    auto inode = static_cast<fuse_ino_t>(
+        folly::hash::fnv64_buf(uuid.data(), uuid.size()));
+
+    while (inode <= FUSE_ROOT_ID || findByInode(inode) != NOT_FOUND) {
+        LOG_DBG(1) << "Inode " << inode << " derived for file " << uuid
+                   << " is already in use";
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.inodecache.collisions");
+        ++inode;
+    }
+
+    return inode;
+}
+
+void InodeCache::linkEvictable(std::uint32_t entryPos)
+{
+    auto &entry = m_entries[entryPos];
+    entry.referenced = true;
+
+    if (m_evictable++ == 0) {
+        entry.prev = entry.next = entryPos;
+        m_clockHand = entryPos;
+        return;
+    }
+
+    // Insert right behind the hand, so that the entry is visited last
+    auto &next = m_entries[m_clockHand];
+    auto &prev = m_entries[next.prev];
+    entry.prev = next.prev;
+    entry.next = m_clockHand;
+    prev.next = entryPos;
+    next.prev = entryPos;
+}
+
+void InodeCache::unlinkEvictable(std::uint32_t entryPos)
+{
+    auto &entry = m_entries[entryPos];
+
+    if (--m_evictable == 0)
+        return;
+
+    m_entries[entry.prev].next = entry.next;
+    m_entries[entry.next].prev = entry.prev;
+    if (m_clockHand == entryPos)
+        m_clockHand = entry.next;
 }
 
 void InodeCache::prune()
 {
     LOG_FCALL();
 
-    auto &index = boost::multi_index::get<ByInode>(m_cache);
-    if (m_cache.size() > m_targetCacheSize && !m_lru.empty()) {
-        index.erase(m_lru.front());
-        m_lru.pop_front();
+    if (m_size <= m_targetCacheSize || m_evictable == 0)
+        return;
+
+    const auto lowWatermark =
+        m_targetCacheSize - m_targetCacheSize / PRUNE_BATCH_DIVISOR;
+
+    // Only evictable entries are in the ring, and each of them is passed by
+    // the hand at most once before it is evicted, as passing it clears its
+    // reference bit
+    std::size_t pruned = 0;
+    while (m_size > lowWatermark && m_evictable > 0) {
+        auto &entry = m_entries[m_clockHand];
+        if (entry.referenced) {
+            entry.referenced = false;
+            m_clockHand = entry.next;
+            continue;
+        }
+
+        erase(m_clockHand);
+        ++pruned;
     }
+
+    LOG_DBG(2) << "Pruned " << pruned << " entries from inode cache";
 }
 
 } // namespace cache
@@ -8,20 +8,29 @@
 
 #pragma once
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
 #include <folly/FBString.h>
-#include <folly/Optional.h>
 #include <fuse/fuse_lowlevel.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace one {
 namespace client {
 namespace cache {
 
+constexpr std::size_t DEFAULT_INODE_CACHE_SIZE = 100000;
+
 /**
  * @c InodeCache is responsible for translating between uuids and inodes.
+ * By default inodes are assigned sequentially. In deterministic mode an inode
+ * is derived from a stable hash of the uuid, so the same file gets the same
+ * inode across remounts and on different clients, unless its hash collides
+ * with an inode already in use, in which case the next free inode is taken.
+ *
+ * Entries are stored in a flat array, indexed both by inode and by uuid with
+ * open-addressing hash tables. Entries which are no longer looked up by the
+ * kernel are linked into an intrusive ring and evicted from it with the CLOCK
+ * algorithm, in batches bringing the cache population below its target size.
  */
 class InodeCache {
 public:
@@ -31,9 +40,11 @@ public:
      * @c FUSE_ROOT_ID .
      * @param targetCacheSize The target size of the cache; the cache will
      * attempt to keep population no bigger than this number.
+     * @param deterministicInodes Whether inodes should be derived from uuids.
      */
-    InodeCache(
-        folly::fbstring rootUuid, const std::size_t targetCacheSize = 100000);
+    InodeCache(folly::fbstring rootUuid,
+        const std::size_t targetCacheSize = DEFAULT_INODE_CACHE_SIZE,
+        const bool deterministicInodes = false);
 
     /**
      * Looks up an number by its uuid and increments lookup count for the
@@ -74,35 +85,75 @@ public:
      */
     void markDeleted(folly::fbstring uuid);
 
-private:
-    void prune();
+    /**
+     * @returns Number of entries in the cache.
+     */
+    std::size_t size() const { return m_size; }
 
-    struct ByInode {
-    };
-    struct ByUuid {
-    };
+    /**
+     * Derives a stable, non-zero generation number from an uuid. Along with
+     * a deterministic inode it distinguishes different files which got the
+     * same inode over time, e.g. after a hash collision has been resolved by
+     * probing.
+     * @param uuid The uuid.
+     * @returns Generation number for the uuid.
+     */
+    static std::uint64_t generation(const folly::fbstring &uuid);
 
+private:
     struct Entry {
-        Entry(fuse_ino_t, folly::fbstring);
-
-        fuse_ino_t inode;
+        fuse_ino_t inode{0};
         folly::fbstring uuid;
-        std::size_t lookupCount{1};
-        folly::Optional<std::list<fuse_ino_t>::iterator> lruIt;
+        std::size_t lookupCount{0};
+        bool used{false};
         bool deleted{false};
+        // Set when the entry becomes evictable, cleared by the CLOCK hand
+        bool referenced{false};
+        // Neighbours in the ring of evictable entries
+        std::uint32_t prev{0};
+        std::uint32_t next{0};
+    };
+
+    /**
+     * Open-addressing hash table with linear probing, storing positions of
+     * entries in @c m_entries offset by one, so that 0 marks an empty slot.
+     */
+    struct Index {
+        std::vector<std::uint32_t> slots;
+        std::size_t used{0};
+        std::size_t tombstones{0};
     };
 
-    using Map = boost::multi_index::multi_index_container<Entry,
-        boost::multi_index::indexed_by<
-            boost::multi_index::ordered_unique<boost::multi_index::tag<ByInode>,
-                boost::multi_index::member<Entry, fuse_ino_t, &Entry::inode>>,
-            boost::multi_index::ordered_unique<boost::multi_index::tag<ByUuid>,
-                boost::multi_index::member<Entry, folly::fbstring,
-                    &Entry::uuid>>>>;
+    static std::size_t hashInode(const fuse_ino_t inode);
+    static std::size_t hashUuid(const folly::fbstring &uuid);
+
+    std::size_t findByInode(const fuse_ino_t inode) const;
+    std::size_t findByUuid(const folly::fbstring &uuid) const;
+    template <typename Equals>
+    std::size_t findSlot(
+        const Index &index, std::size_t hash, Equals &&equals) const;
+    template <typename Hash>
+    void insertSlot(Index &index, std::size_t hash, std::uint32_t entry,
+        Hash &&entryHash);
+    void eraseSlot(Index &index, std::size_t slot);
+    template <typename Hash> void rehash(Index &index, Hash &&entryHash);
+
+    std::uint32_t emplace(fuse_ino_t inode, folly::fbstring uuid);
+    void erase(std::uint32_t entry);
+    void linkEvictable(std::uint32_t entry);
+    void unlinkEvictable(std::uint32_t entry);
+    fuse_ino_t allocateInode(const folly::fbstring &uuid);
+    void prune();
 
     const std::size_t m_targetCacheSize;
-    Map m_cache;
-    std::list<fuse_ino_t> m_lru;
+    const bool m_deterministicInodes;
+    std::vector<Entry> m_entries;
+    std::vector<std::uint32_t> m_freeEntries;
+    Index m_byInode;
+    Index m_byUuid;
+    std::size_t m_size = 0;
+    std::size_t m_evictable = 0;
+    std::uint32_t m_clockHand = 0;
     std::size_t m_nextInode = FUSE_ROOT_ID + 1;
 };
 
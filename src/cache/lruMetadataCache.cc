@@ -24,12 +24,14 @@ LRUMetadataCache::OpenFileToken::~OpenFileToken()
 }
 
 LRUMetadataCache::LRUMetadataCache(communication::Communicator &communicator,
-    const std::size_t targetSize, const std::chrono::seconds providerTimeout)
+    const std::size_t targetSize, const std::chrono::seconds providerTimeout,
+    const bool clockEviction)
     : MetadataCache{communicator, providerTimeout}
     , m_targetSize{targetSize}
+    , m_clockEviction{clockEviction}
 {
     MetadataCache::onRename(std::bind(&LRUMetadataCache::handleRename, this,
-        std::placeholders::_1, std::placeholders::_2));
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 
     MetadataCache::onMarkDeleted(std::bind(
         &LRUMetadataCache::handleMarkDeleted, this, std::placeholders::_1));
@@ -45,15 +47,18 @@ void LRUMetadataCache::pinEntry(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto res = m_lruData.emplace(uuid, LRUData{});
+    // Look the entry up first, as emplace allocates a node even if the
+    // entry already exists
+    auto it = m_lruData.find(uuid);
+    if (it == m_lruData.end()) {
+        it = m_lruData.emplace(uuid, LRUData{}).first;
 
-    if (res.second) {
         // If this uuid was not already in the cache, make sure to create
         // proper subscriptions
-        m_onAdd(uuid);
+        m_onAdd(uuid, {});
     }
 
-    auto &lruData = res.first->second;
+    auto &lruData = it->second;
 
     ++lruData.openCount;
 
@@ -150,36 +155,75 @@ void LRUMetadataCache::putAttr(std::shared_ptr<FileAttr> attr)
     LOG_FCALL();
 
     MetadataCache::putAttr(attr);
-    noteActivity(attr->uuid());
+    noteActivity(attr->uuid(), attr->parentUuid().value_or(""));
 }
 
-void LRUMetadataCache::noteActivity(const folly::fbstring &uuid)
+void LRUMetadataCache::putAttrs(folly::fbvector<FileAttr> attrs)
 {
-    LOG_FCALL() << LOG_FARG(uuid);
+    LOG_FCALL() << LOG_FARG(attrs.size());
 
-    auto res = m_lruData.emplace(uuid, LRUData{});
+    for (auto &attr : attrs) {
+        if (MetadataCache::updateAttr(attr))
+            continue;
 
-    if (res.second) {
+        auto sharedAttr = std::make_shared<FileAttr>(std::move(attr));
+        MetadataCache::putAttr(sharedAttr);
+        trackEntry(sharedAttr->uuid(), sharedAttr->parentUuid().value_or(""));
+    }
+
+    prune();
+}
+
+void LRUMetadataCache::noteActivity(
+    const folly::fbstring &uuid, const folly::fbstring &parentUuid)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(parentUuid);
+
+    trackEntry(uuid, parentUuid);
+    prune();
+}
+
+void LRUMetadataCache::trackEntry(
+    const folly::fbstring &uuid, const folly::fbstring &parentUuid)
+{
+    auto it = m_lruData.find(uuid);
+    if (it == m_lruData.end()) {
         // If this uuid was not already in the cache, make sure to create
         // proper subscriptions
-        res.first->second.lruIt = m_lruList.emplace(m_lruList.end(), uuid);
-        m_onAdd(uuid);
+        auto &lruData = m_lruData.emplace(uuid, LRUData{}).first->second;
+        lruData.lruIt = m_lruList.emplace(m_lruList.end(), uuid);
+        m_onAdd(uuid, parentUuid);
     }
-    else if (res.first->second.lruIt) {
-        m_lruList.splice(m_lruList.end(), m_lruList, *res.first->second.lruIt);
+    else if (m_clockEviction) {
+        it->second.referenced = true;
+    }
+    else if (it->second.lruIt) {
+        m_lruList.splice(m_lruList.end(), m_lruList, *it->second.lruIt);
     }
-
-    prune();
 }
 
 void LRUMetadataCache::prune()
 {
     LOG_FCALL();
 
-    if (m_lruData.size() > m_targetSize && !m_lruList.empty()) {
+    while (m_lruData.size() > m_targetSize && !m_lruList.empty()) {
         LOG_DBG(1) << "Pruning LRU metadata cache front because it exceeds "
                       "target size ("
                    << m_lruData.size() << ">" << m_targetSize << ")";
+
+        if (m_clockEviction) {
+            // The list front acts as the clock hand - give referenced entries
+            // a second chance by moving them behind the hand. This terminates
+            // after at most one full revolution, as each bit is cleared.
+            auto it = m_lruData.find(m_lruList.front());
+            while (it->second.referenced) {
+                it->second.referenced = false;
+                m_lruList.splice(
+                    m_lruList.end(), m_lruList, m_lruList.begin());
+                it = m_lruData.find(m_lruList.front());
+            }
+        }
+
         auto uuid = std::move(m_lruList.front());
         m_lruList.pop_front();
         m_lruData.erase(uuid);
@@ -271,10 +315,11 @@ void LRUMetadataCache::handleMarkDeleted(const folly::fbstring &uuid)
     m_onMarkDeleted(uuid);
 }
 
-void LRUMetadataCache::handleRename(
-    const folly::fbstring &oldUuid, const folly::fbstring &newUuid)
+void LRUMetadataCache::handleRename(const folly::fbstring &oldUuid,
+    const folly::fbstring &newUuid, const folly::fbstring &newParentUuid)
 {
-    LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid);
+    LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid)
+                << LOG_FARG(newParentUuid);
 
     auto it = m_lruData.find(oldUuid);
     if (it == m_lruData.end())
@@ -283,12 +328,13 @@ void LRUMetadataCache::handleRename(
     auto lruData = std::move(it->second);
     m_lruData.erase(it);
 
-    auto res = m_lruData.emplace(newUuid, LRUData{});
-    if (res.second) {
-        res.first->second = std::move(lruData);
-        if (res.first->second.lruIt) {
-            auto oldIt = *(res.first->second.lruIt);
-            res.first->second.lruIt = m_lruList.emplace(oldIt, newUuid);
+    auto newIt = m_lruData.find(newUuid);
+    if (newIt == m_lruData.end()) {
+        auto &newLruData =
+            m_lruData.emplace(newUuid, std::move(lruData)).first->second;
+        if (newLruData.lruIt) {
+            auto oldIt = *newLruData.lruIt;
+            newLruData.lruIt = m_lruList.emplace(oldIt, newUuid);
             m_lruList.erase(oldIt);
         }
     }
@@ -297,7 +343,7 @@ void LRUMetadataCache::handleRename(
                      << "' of rename is already used; merging metadata "
                         "usage records.";
 
-        auto &oldRecord = res.first->second;
+        auto &oldRecord = newIt->second;
         oldRecord.openCount += lruData.openCount;
         oldRecord.deleted = oldRecord.deleted || lruData.deleted;
 
@@ -305,7 +351,7 @@ void LRUMetadataCache::handleRename(
             m_lruList.erase(*lruData.lruIt);
     }
 
-    m_onRename(oldUuid, newUuid);
+    m_onRename(oldUuid, newUuid, newParentUuid);
 }
 
 } // namespace cache
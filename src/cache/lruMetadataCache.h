@@ -13,6 +13,7 @@
 #include "communication/communicator.h"
 
 #include <folly/FBString.h>
+#include <folly/FBVector.h>
 #include <folly/Optional.h>
 
 #include <cstdint>
@@ -65,10 +66,15 @@ public:
      * MetadataCache constructor.
      * @param targetSize The target size of the cache; the cache will attempt
      * to keep population no bigger than this number.
+     * @param providerTimeout Timeout for provider requests.
+     * @param clockEviction Whether to approximate LRU order with the CLOCK
+     * algorithm; an access then only sets the entry's reference bit and
+     * the list is rotated only when pruning.
      */
     LRUMetadataCache(communication::Communicator &communicator,
         const std::size_t targetSize,
-        const std::chrono::seconds providerTimeout);
+        const std::chrono::seconds providerTimeout,
+        const bool clockEviction = false);
 
     /**
      * Sets a pointer to an instance of @c ReaddirCache.
@@ -110,11 +116,21 @@ public:
      */
     void putAttr(std::shared_ptr<FileAttr> attr);
 
+    /**
+     * Updates attributes of cached files and puts the remaining ones in the
+     * cache, pruning it only once for the whole batch.
+     * @param attrs The file attributes, e.g. a page of directory listing.
+     */
+    void putAttrs(folly::fbvector<FileAttr> attrs);
+
     /**
      * Sets a callback that will be called after a file is added to the cache.
-     * @param cb The callback which takes uuid as parameter.
+     * @param cb The callback which takes uuid and parent uuid (empty if not
+     * known) as parameters.
      */
-    void onAdd(std::function<void(const folly::fbstring &)> cb)
+    void onAdd(
+        std::function<void(const folly::fbstring &, const folly::fbstring &)>
+            cb)
     {
         m_onAdd = std::move(cb);
     }
@@ -158,10 +174,10 @@ public:
 
     /**
      * @copydoc MetadataCache::onRename(std::function<void(const folly::fbstring
-     * &, const folly::fbstring &)>)
+     * &, const folly::fbstring &, const folly::fbstring &)>)
      */
-    void onRename(
-        std::function<void(const folly::fbstring &, const folly::fbstring &)>
+    void onRename(std::function<void(const folly::fbstring &,
+            const folly::fbstring &, const folly::fbstring &)>
             cb)
     {
         m_onRename = std::move(cb);
@@ -218,6 +234,7 @@ public:
 
     // Operations used only on open files
     using MetadataCache::addBlock;
+    using MetadataCache::extendSize;
     using MetadataCache::getBlock;
     using MetadataCache::getDefaultBlock;
     using MetadataCache::getSpaceId;
@@ -230,12 +247,17 @@ private:
     struct LRUData {
         std::size_t openCount = 0;
         bool deleted = false;
+        bool referenced = false;
         folly::Optional<std::list<folly::fbstring>::iterator> lruIt;
     };
 
     void pinEntry(const folly::fbstring &uuid);
 
-    void noteActivity(const folly::fbstring &uuid);
+    void noteActivity(
+        const folly::fbstring &uuid, const folly::fbstring &parentUuid = {});
+
+    void trackEntry(
+        const folly::fbstring &uuid, const folly::fbstring &parentUuid);
 
     void release(const folly::fbstring &uuid);
 
@@ -243,21 +265,24 @@ private:
 
     void handleMarkDeleted(const folly::fbstring &uuid);
 
-    void handleRename(
-        const folly::fbstring &oldUuid, const folly::fbstring &newUuid);
+    void handleRename(const folly::fbstring &oldUuid,
+        const folly::fbstring &newUuid, const folly::fbstring &newParentUuid);
 
     const std::size_t m_targetSize;
+    const bool m_clockEviction;
 
     std::list<folly::fbstring> m_lruList;
     std::unordered_map<folly::fbstring, LRUData> m_lruData;
 
-    std::function<void(const folly::fbstring &)> m_onAdd = [](auto &) {};
+    std::function<void(const folly::fbstring &, const folly::fbstring &)>
+        m_onAdd = [](auto &, auto &) {};
     std::function<void(const folly::fbstring &)> m_onOpen = [](auto &) {};
     std::function<void(const folly::fbstring &)> m_onRelease = [](auto &) {};
     std::function<void(const folly::fbstring &)> m_onPrune = [](auto &) {};
     std::function<void(const folly::fbstring &)> m_onMarkDeleted = [](auto) {};
-    std::function<void(const folly::fbstring &, const folly::fbstring &)>
-        m_onRename = [](auto, auto) {};
+    std::function<void(const folly::fbstring &, const folly::fbstring &,
+        const folly::fbstring &)>
+        m_onRename = [](auto, auto, auto) {};
 };
 
 } // namespace cache
@@ -289,6 +289,25 @@ void MetadataCache::truncate(folly::fbstring uuid, const std::size_t newSize)
     });
 }
 
+void MetadataCache::extendSize(
+    const folly::fbstring &uuid, const off_t newSize)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(newSize);
+
+    auto &index = boost::multi_index::get<ByUuid>(m_cache);
+    auto it = index.find(uuid);
+    if (it == index.end()) {
+        LOG_DBG(1) << "Extend size failed - file " << uuid
+                   << " not found in metadata cache";
+        return;
+    }
+
+    if (newSize <= it->attr->size().value_or(0))
+        return;
+
+    index.modify(it, [&](Metadata &m) { m.attr->size(newSize); });
+}
+
 void MetadataCache::updateTimes(
     folly::fbstring uuid, const messages::fuse::UpdateTimes &updateTimes)
 {
@@ -368,6 +387,7 @@ void MetadataCache::markDeletedIt(const Map::iterator &it)
     LOG_FCALL() << LOG_FARG(it->attr->uuid());
 
     auto uuid = it->attr->uuid();
+    auto name = it->attr->name();
     auto parentUuid = it->attr->parentUuid();
 
     m_cache.modify(it, [&](Metadata &m) {
@@ -376,7 +396,7 @@ void MetadataCache::markDeletedIt(const Map::iterator &it)
     });
 
     if (parentUuid)
-        m_readdirCache->invalidate(*(it->attr->parentUuid()));
+        m_readdirCache->removeEntry(*parentUuid, name);
 
     m_onMarkDeleted(uuid);
 }
@@ -410,6 +430,9 @@ bool MetadataCache::rename(folly::fbstring uuid, folly::fbstring newParentUuid,
         m_cache.erase(it);
     }
     else {
+        auto oldName = it->attr->name();
+        auto oldParentUuid = it->attr->parentUuid();
+
         index.modify(it, [&](Metadata &m) {
             m.attr->setName(newName);
             m.attr->setUuid(newUuid);
@@ -417,15 +440,15 @@ bool MetadataCache::rename(folly::fbstring uuid, folly::fbstring newParentUuid,
             m.location = nullptr;
         });
 
-        if (it->attr->parentUuid())
-            m_readdirCache->invalidate(*(it->attr->parentUuid()));
-        m_readdirCache->invalidate(newParentUuid);
+        if (oldParentUuid)
+            m_readdirCache->removeEntry(*oldParentUuid, oldName);
+        m_readdirCache->addEntry(newParentUuid, newName);
 
         LOG_DBG(2) << "Renamed file " << uuid << " to " << newName
                    << " with new uuid " << newUuid << " in " << newParentUuid;
     }
 
-    m_onRename(uuid, newUuid);
+    m_onRename(uuid, newUuid, newParentUuid);
 
     return true;
 }
@@ -154,6 +154,14 @@ public:
      */
     void truncate(folly::fbstring uuid, const std::size_t newSize);
 
+    /**
+     * Extends the size cached in file's attributes, if the new size is larger
+     * than the cached one. File locations are not modified.
+     * @param uuid Uuid of the file.
+     * @param newSize Size to extend to.
+     */
+    void extendSize(const folly::fbstring &uuid, const off_t newSize);
+
     /**
      * Update times cached in file's attributes.
      * @param uuid Uuid of the file.
@@ -224,10 +232,11 @@ public:
 
     /**
      * Sets a callback that will be called after a file is renamed.
-     * @param cb The callback which takes uuid and newUuid as parameters.
+     * @param cb The callback which takes uuid, newUuid and newParentUuid as
+     * parameters.
      */
-    void onRename(
-        std::function<void(const folly::fbstring &, const folly::fbstring &)>
+    void onRename(std::function<void(const folly::fbstring &,
+            const folly::fbstring &, const folly::fbstring &)>
             cb)
     {
         m_onRename = std::move(cb);
@@ -290,8 +299,9 @@ private:
     Map m_cache;
 
     std::function<void(const folly::fbstring &)> m_onMarkDeleted = [](auto) {};
-    std::function<void(const folly::fbstring &, const folly::fbstring &)>
-        m_onRename = [](auto, auto) {};
+    std::function<void(const folly::fbstring &, const folly::fbstring &,
+        const folly::fbstring &)>
+        m_onRename = [](auto, auto, auto) {};
 
     std::shared_ptr<ReaddirCache> m_readdirCache;
 
@@ -11,18 +11,20 @@
 #include "communication/communicator.h"
 #include "helpers/logging.h"
 #include "options/options.h"
+#include "util/timingWheel.h"
 #include "util/uuid.h"
 
 #include "messages/fuse/fileChildrenAttrs.h"
 #include "messages/fuse/getFileChildren.h"
 #include "messages/fuse/getFileChildrenAttrs.h"
-#include <folly/Enumerate.h>
 #include <folly/FBString.h>
 #include <folly/Optional.h>
 #include <folly/Range.h>
 #include <fuse/fuse_lowlevel.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace one {
 namespace client {
@@ -43,6 +45,7 @@ DirCacheEntry::DirCacheEntry(const DirCacheEntry &e)
     , m_dirEntries{e.m_dirEntries}
     , m_cacheValidityPeriod{e.m_cacheValidityPeriod}
 {
+    rebuildIndex();
 }
 
 DirCacheEntry::DirCacheEntry(DirCacheEntry &&e) noexcept
@@ -50,6 +53,7 @@ DirCacheEntry::DirCacheEntry(DirCacheEntry &&e) noexcept
     , m_atime{e.m_atime.load()}
     , m_invalid{e.m_invalid.load()}
     , m_dirEntries{std::move(e.m_dirEntries)}
+    , m_dirEntriesIndex{std::move(e.m_dirEntriesIndex)}
     , m_cacheValidityPeriod{e.m_cacheValidityPeriod}
 {
 }
@@ -57,11 +61,35 @@ DirCacheEntry::DirCacheEntry(DirCacheEntry &&e) noexcept
 void DirCacheEntry::addEntry(const folly::fbstring &name)
 {
     m_dirEntries.emplace_back(name);
+    m_dirEntriesIndex.emplace(name, std::prev(m_dirEntries.end()));
 }
 
 void DirCacheEntry::addEntry(folly::fbstring &&name)
 {
     m_dirEntries.emplace_back(std::forward<folly::fbstring>(name));
+    m_dirEntriesIndex.emplace(
+        m_dirEntries.back(), std::prev(m_dirEntries.end()));
+}
+
+bool DirCacheEntry::insertEntry(const folly::fbstring &name)
+{
+    if (m_dirEntriesIndex.find(name) != m_dirEntriesIndex.end())
+        return false;
+
+    // Append at the end, so that offsets of listings in progress remain valid
+    addEntry(name);
+    return true;
+}
+
+bool DirCacheEntry::removeEntry(const folly::fbstring &name)
+{
+    auto indexIt = m_dirEntriesIndex.find(name);
+    if (indexIt == m_dirEntriesIndex.end())
+        return false;
+
+    m_dirEntries.erase(indexIt->second);
+    m_dirEntriesIndex.erase(indexIt);
+    return true;
 }
 
 const std::list<folly::fbstring> &DirCacheEntry::dirEntries() const
@@ -108,6 +136,15 @@ void DirCacheEntry::unique()
 {
     m_dirEntries.sort();
     m_dirEntries.unique();
+    rebuildIndex();
+}
+
+void DirCacheEntry::rebuildIndex()
+{
+    m_dirEntriesIndex.clear();
+    m_dirEntriesIndex.reserve(m_dirEntries.size());
+    for (auto it = m_dirEntries.begin(); it != m_dirEntries.end(); ++it)
+        m_dirEntriesIndex.emplace(*it, it);
 }
 
 ReaddirCache::ReaddirCache(LRUMetadataCache &metadataCache,
@@ -117,6 +154,8 @@ ReaddirCache::ReaddirCache(LRUMetadataCache &metadataCache,
     , m_context{std::move(context)}
     , m_providerTimeout(m_context.lock()->options()->getProviderTimeout())
     , m_prefetchSize(m_context.lock()->options()->getReaddirPrefetchSize())
+    , m_prefetchFanout(std::max<std::size_t>(
+          1, m_context.lock()->options()->getReaddirPrefetchFanout()))
     , m_rootUuid{std::move(rootUuid)}
     , m_runInFiber{std::move(runInFiber)}
 {
@@ -153,11 +192,34 @@ void ReaddirCache::fetch(const folly::fbstring &uuid)
             std::size_t fetchedSize = 0;
             auto isLast = false;
 
+            // Hand over the whole page to the metadata cache in a single
+            // fiber task
+            auto storeChildren = [&](
+                one::messages::fuse::FileChildrenAttrs &msg) {
+                folly::fbvector<FileAttr> attrs;
+                attrs.reserve(msg.childrenAttrs().size());
+
+                for (auto &attr : msg.childrenAttrs()) {
+                    cacheEntry->addEntry(attr.name());
+
+                    if (uuid == m_rootUuid && !isSpaceWhitelisted(attr.name()))
+                        continue;
+
+                    attrs.emplace_back(std::move(attr));
+                }
+
+                chunkIndex += msg.childrenAttrs().size();
+
+                m_runInFiber([ this, attrs = std::move(attrs) ]() mutable {
+                    m_metadataCache.putAttrs(std::move(attrs));
+                });
+            };
+
             // Start with empty index token, and then if server returns
             // index token pass to next request.
             folly::Optional<folly::fbstring> indexToken;
 
-            do {
+            auto fetchPage = [&] {
                 LOG_DBG(2) << "Requesting directory entries for directory "
                            << uuid << " starting at offset " << chunkIndex;
 
@@ -171,31 +233,70 @@ void ReaddirCache::fetch(const folly::fbstring &uuid)
                 indexToken.assign(msg.indexToken());
                 isLast = msg.isLast() && *msg.isLast();
 
-                for (const auto it : folly::enumerate(msg.childrenAttrs())) {
-                    cacheEntry->addEntry(it->name());
+                storeChildren(msg);
+            };
+
+            auto fetchPagesInParallel = [&] {
+                LOG_DBG(2) << "Requesting " << m_prefetchFanout
+                           << " pages of directory entries for directory "
+                           << uuid << " starting at offset " << chunkIndex;
+
+                std::vector<
+                    folly::Future<one::messages::fuse::FileChildrenAttrs>>
+                    pages;
+                for (std::size_t i = 0; i < m_prefetchFanout; ++i) {
+                    pages.emplace_back(
+                        m_context.lock()
+                            ->communicator()
+                            ->communicate<
+                                one::messages::fuse::FileChildrenAttrs>(
+                                one::messages::fuse::GetFileChildrenAttrs{uuid,
+                                    static_cast<off_t>(
+                                        chunkIndex + i * m_prefetchSize),
+                                    m_prefetchSize}));
+                }
+
+                // The index token is only valid for the page following the
+                // one it was returned with
+                indexToken.clear();
+
+                // Merge the pages in order, until the last or a short one
+                for (auto &page : pages) {
+                    auto msg =
+                        communication::wait(std::move(page), m_providerTimeout);
 
-                    if (uuid == m_rootUuid && !isSpaceWhitelisted(it->name()))
+                    if (isLast || fetchedSize < m_prefetchSize)
                         continue;
 
-                    m_runInFiber([ this, attr = *it ] {
-                        if (!m_metadataCache.updateAttr(attr)) {
-                            m_metadataCache.putAttr(
-                                std::make_shared<FileAttr>(attr));
-                        }
-                    });
+                    fetchedSize = msg.childrenAttrs().size();
+                    isLast = msg.isLast() && *msg.isLast();
+
+                    storeChildren(msg);
                 }
+            };
 
-                chunkIndex = cacheEntry->dirEntries().size() - 2;
+            fetchPage();
 
-            } while (!isLast && fetchedSize > 0);
+            // A full page means the directory is large, so the following
+            // pages are requested by offset several at a time. After a short
+            // page which is not the last one, the paging falls back to
+            // sequential requests.
+            while (!isLast && fetchedSize > 0) {
+                if (m_prefetchFanout > 1 && fetchedSize == m_prefetchSize)
+                    fetchPagesInParallel();
+                else
+                    fetchPage();
+            }
 
             cacheEntry->unique();
             cacheEntry->touch();
             cacheEntry->markCreated();
 
-            m_context.lock()->scheduler()->schedule(4 * m_cacheValidityPeriod, [
-                uuid = uuid, cacheEntry = cacheEntry, self = shared_from_this()
-            ]() { self->purgeWorker(uuid, cacheEntry); });
+            m_context.lock()->timingWheel()->schedule(
+                4 * m_cacheValidityPeriod, [
+                    uuid = uuid, cacheEntry = cacheEntry,
+                    self = shared_from_this()
+                ]() { self->purgeWorker(uuid, cacheEntry); });
 
             return cacheEntry;
         });
@@ -216,7 +317,7 @@ void ReaddirCache::purgeWorker(
         LOG_DBG(2) << "Readdir cache entry " << uuid
                    << " still valid - scheduling next purge";
 
-        m_context.lock()->scheduler()->schedule(2 * m_cacheValidityPeriod, [
+        m_context.lock()->timingWheel()->schedule(2 * m_cacheValidityPeriod, [
             uuid = std::move(uuid), entry = std::move(entry),
             self = shared_from_this()
         ]() { self->purgeWorker(uuid, entry); });
@@ -338,6 +439,47 @@ void ReaddirCache::invalidate(const folly::fbstring &uuid)
     }
 }
 
+void ReaddirCache::addEntry(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto entry = fetchedEntry(uuid);
+    if (entry && entry->insertEntry(name)) {
+        LOG_DBG(2) << "Added " << name << " to readdir cache entry " << uuid;
+    }
+}
+
+void ReaddirCache::removeEntry(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto entry = fetchedEntry(uuid);
+    if (entry && entry->removeEntry(name)) {
+        LOG_DBG(2) << "Removed " << name << " from readdir cache entry "
+                   << uuid;
+    }
+}
+
+std::shared_ptr<DirCacheEntry> ReaddirCache::fetchedEntry(
+    const folly::fbstring &uuid)
+{
+    auto it = m_cache.find(uuid);
+    if (it == m_cache.cend() || !(*it).second->isFulfilled())
+        return {};
+
+    auto f = (*it).second->getFuture();
+    if (f.hasException() || !f.value()->isValid(false))
+        return {};
+
+    return f.value();
+}
+
 void ReaddirCache::purge(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <list>
+#include <unordered_map>
 
 namespace one {
 namespace client {
@@ -50,6 +51,22 @@ public:
     void addEntry(const folly::fbstring &name);
     void addEntry(folly::fbstring &&name);
 
+    /**
+     * Add directory entry to cache unless it is already present.
+     *
+     * @param name Directory entry name.
+     * @return True if the entry was added.
+     */
+    bool insertEntry(const folly::fbstring &name);
+
+    /**
+     * Remove directory entry from cache.
+     *
+     * @param name Directory entry name.
+     * @return True if the entry was present.
+     */
+    bool removeEntry(const folly::fbstring &name);
+
     /**
      * Returns const reference to the directory entries.
      */
@@ -90,6 +107,8 @@ public:
     void unique();
 
 private:
+    void rebuildIndex();
+
     /**
      * Absolute creation time.
      */
@@ -110,9 +129,18 @@ private:
      * The directory entries list doesn't have to be locked for now as
      * it is only filled by a single thread and cannot be accessed
      * by other threads until is completely fetched from the provider.
+     * Afterwards it is only read and patched from the fslogic fiber.
      */
     std::list<folly::fbstring> m_dirEntries;
 
+    /**
+     * Positions of the directory entries in @c m_dirEntries by name, so that
+     * entries can be found without scanning the whole list.
+     */
+    std::unordered_multimap<folly::fbstring,
+        std::list<folly::fbstring>::iterator>
+        m_dirEntriesIndex;
+
     /**
      * Validity period of dir cache entries.
      *
@@ -162,6 +190,24 @@ public:
      */
     void invalidate(const folly::fbstring &uuid);
 
+    /**
+     * Add a name to the cached listing of a directory, if the listing is
+     * already fetched and valid.
+     *
+     * @param uuid Directory id.
+     * @param name Name of the new directory entry.
+     */
+    void addEntry(const folly::fbstring &uuid, const folly::fbstring &name);
+
+    /**
+     * Remove a name from the cached listing of a directory, if the listing
+     * is already fetched and valid.
+     *
+     * @param uuid Directory id.
+     * @param name Name of the removed directory entry.
+     */
+    void removeEntry(const folly::fbstring &uuid, const folly::fbstring &name);
+
     /**
      * Returns true if cache doesn't contain any elements.
      */
@@ -186,6 +232,12 @@ private:
      */
     void fetch(const folly::fbstring &uuid);
 
+    /**
+     * Returns the valid, completely fetched cache entry for a directory or
+     * nullptr. Must be called with @c m_cacheMutex held.
+     */
+    std::shared_ptr<DirCacheEntry> fetchedEntry(const folly::fbstring &uuid);
+
     /**
      * Removes element cache for specific directory.
      */
@@ -238,6 +290,12 @@ private:
      */
     const std::size_t m_prefetchSize;
 
+    /**
+     * The maximum number of 'fetch' requests issued in parallel once the
+     * directory turns out to span multiple pages.
+     */
+    const std::size_t m_prefetchFanout;
+
     const folly::fbstring m_rootUuid;
     std::unordered_set<folly::fbstring> m_whitelistedSpaceNames;
     std::unordered_set<folly::fbstring> m_whitelistedSpaceIds;
@@ -79,7 +79,7 @@ std::shared_ptr<auth::AuthManager> getAuthManager(
     }
 }
 
-std::shared_ptr<messages::Configuration> getConfiguration(
+std::shared_ptr<messages::Configuration> requestConfiguration(
     const std::string &sessionId,
     std::shared_ptr<auth::AuthManager> authManager,
     std::shared_ptr<Context> context)
@@ -89,21 +89,29 @@ std::shared_ptr<messages::Configuration> getConfiguration(
               << ":" << options->getProviderPort() << "' using session ID: '"
               << sessionId << "'..." << std::endl;
 
-    try {
-        auto communicator =
-            handshake(sessionId, std::move(authManager), std::move(context));
+    auto communicator =
+        handshake(sessionId, std::move(authManager), std::move(context));
 
-        std::cout << "Getting configuration..." << std::endl;
+    std::cout << "Getting configuration..." << std::endl;
 
-        auto future = communicator->communicate<messages::Configuration>(
-            messages::GetConfiguration{});
-        auto configuration =
-            communication::wait(future, options->getProviderTimeout());
+    auto future = communicator->communicate<messages::Configuration>(
+        messages::GetConfiguration{});
+    auto configuration =
+        communication::wait(future, options->getProviderTimeout());
 
-        communicator->stop();
+    communicator->stop();
 
-        return std::make_shared<messages::Configuration>(
-            std::move(configuration));
+    return std::make_shared<messages::Configuration>(std::move(configuration));
+}
+
+std::shared_ptr<messages::Configuration> getConfiguration(
+    const std::string &sessionId,
+    std::shared_ptr<auth::AuthManager> authManager,
+    std::shared_ptr<Context> context)
+{
+    try {
+        return requestConfiguration(
+            sessionId, std::move(authManager), std::move(context));
     }
     catch (const std::exception &e) {
         std::cerr << "Connection refused - aborting..." << std::endl;
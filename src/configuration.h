@@ -23,6 +23,16 @@ std::shared_ptr<communication::Communicator> handshake(
 std::shared_ptr<auth::AuthManager> getAuthManager(
     std::shared_ptr<Context> context);
 
+/**
+ * Performs a test connection to the provider and retrieves the
+ * configuration.
+ * @throws On connection, handshake or configuration request failure.
+ */
+std::shared_ptr<messages::Configuration> requestConfiguration(
+    const std::string &sessionId,
+    std::shared_ptr<auth::AuthManager> authManager,
+    std::shared_ptr<Context> context);
+
 std::shared_ptr<messages::Configuration> getConfiguration(
     const std::string &sessionId,
     std::shared_ptr<auth::AuthManager> authManager,
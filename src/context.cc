@@ -7,6 +7,7 @@
  */
 
 #include "context.h"
+#include "util/timingWheel.h"
 
 #include <algorithm>
 #include <atomic>
@@ -38,6 +39,18 @@ void Context::setScheduler(std::shared_ptr<Scheduler> sched)
     m_scheduler = std::move(sched);
 }
 
+std::shared_ptr<util::TimingWheel> Context::timingWheel() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock{m_timingWheelMutex};
+    return m_timingWheel;
+}
+
+void Context::setTimingWheel(std::shared_ptr<util::TimingWheel> wheel)
+{
+    std::lock_guard<std::shared_timed_mutex> guard{m_timingWheelMutex};
+    m_timingWheel = std::move(wheel);
+}
+
 std::shared_ptr<communication::Communicator> Context::communicator() const
 {
     std::shared_lock<std::shared_timed_mutex> lock{m_communicatorMutex};
@@ -35,6 +35,14 @@ public:
      * @return A collection of aggregated events.
      */
     virtual Events<T> flush() = 0;
+
+    /**
+     * Returns aggregated events with a given aggregation key, leaving other
+     * events in the container.
+     * @param aggregationKey An aggregation key of events to return.
+     * @return A collection of aggregated events.
+     */
+    virtual Events<T> flush(const AggregationKey &aggregationKey) = 0;
 };
 
 } // namespace events
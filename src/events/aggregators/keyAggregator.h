@@ -41,6 +41,12 @@ public:
      */
     Events<T> flush() override;
 
+    /**
+     * Returns an event aggregated under a given aggregation key, if present.
+     * @see Aggregator::flush(const AggregationKey &aggregationKey)
+     */
+    Events<T> flush(const AggregationKey &aggregationKey) override;
+
 private:
     std::unordered_map<AggregationKey, EventPtr<T>> m_events;
 };
@@ -77,6 +83,21 @@ template <class T> Events<T> KeyAggregator<T>::flush()
     return events;
 }
 
+template <class T>
+Events<T> KeyAggregator<T>::flush(const AggregationKey &aggregationKey)
+{
+    LOG_FCALL() << LOG_FARG(aggregationKey);
+
+    Events<T> events;
+    auto it = m_events.find(aggregationKey);
+    if (it != m_events.end()) {
+        LOG_DBG(2) << "Emitting event: " << it->second->toString();
+        events.emplace_back(std::move(it->second));
+        m_events.erase(it);
+    }
+    return events;
+}
+
 } // namespace events
 } // namespace client
 } // namespace one
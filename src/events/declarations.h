@@ -36,6 +36,9 @@ class SubscriptionCancellation;
 class ClientMessage;
 } // namespace clproto
 namespace client {
+namespace util {
+class TimingWheel;
+} // namespace util
 namespace events {
 
 template <class T> class Aggregator;
@@ -47,10 +50,13 @@ class Stream;
 class SharedStream;
 class Subscription;
 class SubscriptionHandle;
+template <class Scheduler = one::Scheduler> class SubscriptionBatcher;
 
 constexpr std::chrono::milliseconds DEFAULT_TIMED_EMITTER_THRESHOLD{500};
+constexpr std::chrono::milliseconds DEFAULT_SUBSCRIPTION_BATCH_INTERVAL{100};
 
 using AggregationKey = std::string;
+using TimingWheel = util::TimingWheel;
 using SequencerManager = communication::StreamManager;
 using SequencerStream = SequencerManager::Stream;
 using FileAttr = messages::fuse::FileAttr;
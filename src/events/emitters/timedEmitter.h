@@ -13,6 +13,7 @@
 #include "events/manager.h"
 #include "events/streams/stream.h"
 #include "falseEmitter.h"
+#include "util/timingWheel.h"
 
 #include <chrono>
 #include <functional>
@@ -25,7 +26,7 @@ namespace events {
 /**
  * @c TimedEmitter is responsible for periodic event stream flush.
  */
-template <class T, class Scheduler = Scheduler>
+template <class T, class Scheduler = TimingWheel>
 class TimedEmitter : public Emitter<T> {
 public:
     /**
@@ -34,7 +35,8 @@ public:
      * @param threshold A period, measured since a first processed event after a
      * reset, after which emitter request a stream flush.
      * @param manager A @c Manager instance used to flush a stream.
-     * @param scheduler A @c Scheduler instance used to schedule a stream flush.
+     * @param scheduler A @c TimingWheel instance used to schedule a stream
+     * flush.
      * @param emitter A wrapped @c Emitter instance.
      */
     TimedEmitter(StreamKey streamKey, std::chrono::milliseconds threshold,
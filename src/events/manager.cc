@@ -11,6 +11,7 @@
 #include "helpers/logging.h"
 #include "messages/configuration.h"
 #include "scheduler.h"
+#include "util/timingWheel.h"
 
 namespace one {
 namespace client {
@@ -18,8 +19,13 @@ namespace events {
 
 Manager::Manager(std::shared_ptr<Context> context)
     : m_scheduler{*context->scheduler()}
+    , m_timingWheel{*context->timingWheel()}
     , m_sequencerManager{context->communicator()}
     , m_sequencerStream{m_sequencerManager.create()}
+    , m_subscriptionBatcher{[this](ProtoClientPtr msg) {
+                                m_sequencerStream->send(std::move(msg));
+                            },
+          m_scheduler}
     , m_router{*this, *context->communicator()}
 {
 }
@@ -51,7 +57,8 @@ std::int64_t Manager::subscribe(
                    << "' for subscription " << subscription.toString();
 
         streamAcc->second = std::make_unique<SharedStream>(
-            subscription.createStream(*this, m_sequencerManager, m_scheduler));
+            subscription.createStream(
+                *this, m_sequencerManager, m_timingWheel));
     }
     else {
         streamAcc->second->share();
@@ -64,7 +71,7 @@ std::int64_t Manager::subscribe(
     HandleAcc handleAcc;
     m_handles.insert(handleAcc, subscriptionId);
     handleAcc->second = subscription.createHandle(
-        subscriptionId, m_streams, *m_sequencerStream);
+        subscriptionId, m_streams, m_subscriptionBatcher);
 
     return subscriptionId;
 }
@@ -120,6 +127,19 @@ void Manager::flush(StreamKey streamKey)
     }
 }
 
+void Manager::flush(const AggregationKey &aggregationKey)
+{
+    LOG_FCALL() << LOG_FARG(aggregationKey);
+
+    for (int it = static_cast<int>(StreamKey::FILE_READ);
+         it != static_cast<int>(StreamKey::TEST); ++it) {
+        StreamConstAcc streamAcc;
+        if (m_streams.find(streamAcc, static_cast<StreamKey>(it))) {
+            streamAcc->second->flush(aggregationKey);
+        }
+    }
+}
+
 } // namespace events
 } // namespace client
 } // namespace one
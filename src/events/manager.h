@@ -11,6 +11,7 @@
 
 #include "events/declarations.h"
 #include "router.h"
+#include "subscriptions/subscriptionBatcher.h"
 
 #include <atomic>
 #include <string>
@@ -92,6 +93,14 @@ public:
      */
     virtual void flush(StreamKey streamKey);
 
+    /**
+     * Requests handling of events aggregated under a given aggregation key in
+     * all streams, leaving events with other keys aggregated.
+     * @param aggregationKey An aggregation key, e.g. a file UUID, of events
+     * that should be flushed.
+     */
+    virtual void flush(const AggregationKey &aggregationKey);
+
 private:
     std::int64_t subscribe(
         std::int64_t subscriptionId, const Subscription &subscription);
@@ -100,8 +109,10 @@ private:
 
     Streams m_streams;
     Scheduler &m_scheduler;
+    TimingWheel &m_timingWheel;
     SequencerManager m_sequencerManager;
     SequencerStreamPtr m_sequencerStream;
+    SubscriptionBatcher<> m_subscriptionBatcher;
     Router m_router;
     tbb::concurrent_hash_map<std::int64_t, SubscriptionHandlePtr> m_handles;
 
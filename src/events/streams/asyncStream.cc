@@ -10,36 +10,130 @@
 
 #include "events/types/event.h"
 #include "helpers/logging.h"
+#include "monitoring/monitoring.h"
 
 #include <folly/ThreadName.h>
 
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
 namespace one {
 namespace client {
 namespace events {
 
-AsyncStream::AsyncStream(StreamPtr stream)
-    : m_ioService{1}
+AsyncStreamExecutor::AsyncStreamExecutor(std::size_t threads)
+    : m_ioService{static_cast<int>(threads)}
     , m_idleWork{asio::make_work_guard(m_ioService)}
-    , m_worker{[=] {
-        folly::setThreadName("AsyncStream");
-        m_ioService.run();
-    }}
-    , m_stream{std::move(stream)}
 {
+    for (std::size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back([this] {
+            folly::setThreadName("AsyncStream");
+            m_ioService.run();
+        });
 }
 
-AsyncStream::~AsyncStream()
+AsyncStreamExecutor::~AsyncStreamExecutor()
 {
+    assert(!isWorkerThread());
+
     m_ioService.stop();
-    m_worker.join();
+    for (auto &worker : m_workers)
+        worker.join();
+}
+
+bool AsyncStreamExecutor::isWorkerThread() const
+{
+    return std::any_of(m_workers.begin(), m_workers.end(),
+        [](const auto &worker) {
+            return worker.get_id() == std::this_thread::get_id();
+        });
+}
+
+std::shared_ptr<AsyncStreamExecutor> AsyncStreamExecutor::instance()
+{
+    static std::mutex mutex;
+    static std::weak_ptr<AsyncStreamExecutor> executor;
+
+    std::lock_guard<std::mutex> guard{mutex};
+    auto instance = executor.lock();
+    if (!instance) {
+        instance = std::shared_ptr<AsyncStreamExecutor>{
+            new AsyncStreamExecutor{ASYNC_STREAM_EXECUTOR_THREADS},
+            [](AsyncStreamExecutor *executor) {
+                // The last stream can be destroyed by a handler of another
+                // stream, in which case the executor cannot join its own
+                // worker and is destroyed in a separate thread, after the
+                // handler returns
+                if (executor->isWorkerThread())
+                    std::thread{[executor] { delete executor; }}.detach();
+                else
+                    delete executor;
+            }};
+        executor = instance;
+    }
+
+    return instance;
+}
+
+namespace {
+std::string queueDepthMetricName(StreamKey key)
+{
+    std::stringstream name;
+    name << "comp.oneclient.mod.events.submod.streams." << key << ".queue";
+    return name.str();
+}
+} // namespace
+
+AsyncStream::State::State(
+    asio::io_service &ioService, StreamPtr stream_, StreamKey key)
+    : strand{ioService}
+    , stream{std::move(stream_)}
+    , queueDepthMetric{queueDepthMetricName(key)}
+{
+}
+
+AsyncStream::AsyncStream(StreamPtr stream, StreamKey key)
+    : m_executor{AsyncStreamExecutor::instance()}
+    , m_state{std::make_shared<State>(
+          m_executor->ioService(), std::move(stream), key)}
+{
+}
+
+AsyncStream::~AsyncStream()
+{
+    StreamPtr stream;
+    {
+        std::lock_guard<std::mutex> guard{m_state->mutex};
+        m_state->closed = true;
+        stream = std::move(m_state->stream);
+    }
+
+    ONE_METRIC_COUNTER_SET(m_state->queueDepthMetric, 0);
+}
+
+template <typename F> void AsyncStream::post(F &&f)
+{
+    ++m_state->queueDepth;
+    ONE_METRIC_COUNTER_INC(m_state->queueDepthMetric);
+
+    asio::post(m_state->strand,
+        [ state = m_state, f = std::forward<F>(f) ]() mutable {
+            --state->queueDepth;
+            ONE_METRIC_COUNTER_DEC(state->queueDepthMetric);
+
+            std::lock_guard<std::mutex> guard{state->mutex};
+            if (!state->closed)
+                f(*state->stream);
+        });
 }
 
 void AsyncStream::process(EventPtr<> event)
 {
     LOG_FCALL();
 
-    asio::post(m_ioService, [ this, event = std::move(event) ]() mutable {
-        m_stream->process(std::move(event));
+    post([event = std::move(event)](Stream & stream) mutable {
+        stream.process(std::move(event));
     });
 }
 
@@ -47,7 +141,14 @@ void AsyncStream::flush()
 {
     LOG_FCALL();
 
-    asio::post(m_ioService, [this] { m_stream->flush(); });
+    post([](Stream &stream) { stream.flush(); });
+}
+
+void AsyncStream::flush(const AggregationKey &aggregationKey)
+{
+    LOG_FCALL() << LOG_FARG(aggregationKey);
+
+    post([aggregationKey](Stream & stream) { stream.flush(aggregationKey); });
 }
 
 } // namespace events
@@ -9,6 +9,7 @@
 #ifndef ONECLIENT_EVENTS_STREAMS_ASYNC_STREAM_H
 #define ONECLIENT_EVENTS_STREAMS_ASYNC_STREAM_H
 
+#include "events/streams.h"
 #include "stream.h"
 
 #include <asio/io_service.hpp>
@@ -16,49 +17,130 @@
 #include <asio/post.hpp>
 #include <asio/ts/executor.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace one {
 namespace client {
 namespace events {
 
 /**
- * @c AsyncStream is an event stream wrapper that processes events in a single,
- * dedicated thread managed by an IO service. Therefore, synchronization
- * mechanisms are not necessary within the @c AsyncStream.
+ * Number of worker threads shared by all @c AsyncStream instances.
+ */
+constexpr std::size_t ASYNC_STREAM_EXECUTOR_THREADS = 2;
+
+/**
+ * @c AsyncStreamExecutor is an IO service with a fixed pool of worker threads,
+ * shared by all @c AsyncStream instances. It is created along with the first
+ * @c AsyncStream and destroyed along with the last one.
+ */
+class AsyncStreamExecutor {
+public:
+    /**
+     * Constructor.
+     * @param threads Number of worker threads.
+     */
+    explicit AsyncStreamExecutor(std::size_t threads);
+
+    /**
+     * Stops IO service and joins worker threads. Must not be called from
+     * a worker thread.
+     */
+    ~AsyncStreamExecutor();
+
+    /**
+     * @returns An executor instance shared by all living @c AsyncStream
+     * instances, creating it if necessary.
+     */
+    static std::shared_ptr<AsyncStreamExecutor> instance();
+
+    /**
+     * @returns The IO service run by worker threads.
+     */
+    asio::io_service &ioService() { return m_ioService; }
+
+    /**
+     * @returns Number of worker threads.
+     */
+    std::size_t threads() const { return m_workers.size(); }
+
+    /**
+     * @returns true if called from one of the worker threads.
+     */
+    bool isWorkerThread() const;
+
+private:
+    asio::io_service m_ioService;
+    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork;
+    std::vector<std::thread> m_workers;
+};
+
+/**
+ * @c AsyncStream is an event stream wrapper that processes events
+ * asynchronously in a strand of the shared @c AsyncStreamExecutor. The strand
+ * guarantees that no two calls of the wrapped stream run concurrently, so
+ * synchronization mechanisms are not necessary within the @c AsyncStream,
+ * while all streams share a small pool of threads.
  */
 class AsyncStream : public Stream {
 public:
     /**
      * Constructor.
      * @param stream A wrapped @c Stream instance.
+     * @param key A key of the wrapped stream, used to name its queue depth
+     * metric.
      */
-    AsyncStream(StreamPtr stream);
+    AsyncStream(StreamPtr stream, StreamKey key = StreamKey::TEST);
 
     /**
-     * Stops IO service and joins worker thread.
+     * Drops events not yet processed and destroys the wrapped stream once
+     * the currently processed call, if any, returns.
      */
     ~AsyncStream();
 
     /**
-     * Forwards call to a wrapped stream managed by a single, dedicated worker
-     * thread.
+     * Forwards call to a wrapped stream in the stream's strand.
      * @see Stream::process(EventPtr<> event)
      */
     void process(EventPtr<> event) override;
 
     /**
-     * Forwards call to a wrapped stream managed by a single, dedicated worker
-     * thread.
+     * Forwards call to a wrapped stream in the stream's strand.
      * @see Stream::flush()
      */
     void flush() override;
 
+    /**
+     * Forwards call to a wrapped stream in the stream's strand.
+     * @see Stream::flush(const AggregationKey &aggregationKey)
+     */
+    void flush(const AggregationKey &aggregationKey) override;
+
+    /**
+     * @returns Number of calls waiting to be forwarded to the wrapped stream.
+     */
+    std::size_t queueDepth() const { return m_state->queueDepth; }
+
 private:
-    asio::io_service m_ioService;
-    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork;
-    std::thread m_worker;
-    StreamPtr m_stream;
+    struct State {
+        State(asio::io_service &ioService, StreamPtr stream_, StreamKey key);
+
+        asio::io_service::strand strand;
+        StreamPtr stream;
+        std::mutex mutex;
+        bool closed = false;
+        std::atomic<std::size_t> queueDepth{0};
+        const std::string queueDepthMetric;
+    };
+
+    template <typename F> void post(F &&f);
+
+    std::shared_ptr<AsyncStreamExecutor> m_executor;
+    std::shared_ptr<State> m_state;
 };
 
 } // namespace events
@@ -32,6 +32,12 @@ void SharedStream::flush()
     m_stream->flush();
 }
 
+void SharedStream::flush(const AggregationKey &aggregationKey)
+{
+    LOG_FCALL() << LOG_FARG(aggregationKey);
+    m_stream->flush(aggregationKey);
+}
+
 void SharedStream::share() { ++m_counter; }
 
 bool SharedStream::release()
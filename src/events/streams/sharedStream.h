@@ -40,6 +40,12 @@ public:
      */
     void flush() override;
 
+    /**
+     * Forwards call to a wrapped stream.
+     * @see Stream::flush(const AggregationKey &aggregationKey)
+     */
+    void flush(const AggregationKey &aggregationKey) override;
+
     /**
      * Increments subscriptions reference count.
      */
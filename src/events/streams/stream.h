@@ -33,6 +33,13 @@ public:
      * Requests handling of events aggregated in the stream.
      */
     virtual void flush() = 0;
+
+    /**
+     * Requests handling of events aggregated in the stream under a given
+     * aggregation key, leaving other events aggregated.
+     * @param aggregationKey An aggregation key of events to handle.
+     */
+    virtual void flush(const AggregationKey &aggregationKey) = 0;
 };
 
 } // namespace events
@@ -52,6 +52,12 @@ public:
      */
     void flush() override;
 
+    /**
+     * Calls a handler on events aggregated under a given aggregation key.
+     * The emitter is not reset, as other events remain aggregated.
+     */
+    void flush(const AggregationKey &aggregationKey) override;
+
 private:
     AggregatorPtr<T> m_aggregator;
     EmitterPtr<T> m_emitter;
@@ -93,6 +99,12 @@ template <class T> void TypedStream<T>::flush()
     m_emitter->reset();
 }
 
+template <class T>
+void TypedStream<T>::flush(const AggregationKey &aggregationKey)
+{
+    m_handler->process(m_aggregator->flush(aggregationKey));
+}
+
 } // namespace events
 } // namespace client
 } // namespace one
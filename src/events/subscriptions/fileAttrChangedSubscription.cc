@@ -30,16 +30,17 @@ StreamKey FileAttrChangedSubscription::streamKey() const
 }
 
 StreamPtr FileAttrChangedSubscription::createStream(Manager &manager,
-    SequencerManager & /*seqManager*/, Scheduler &scheduler) const
+    SequencerManager & /*seqManager*/, TimingWheel &timingWheel) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileAttrChanged>>();
     auto emitter = std::make_unique<TimedEmitter<FileAttrChanged>>(
-        streamKey(), DEFAULT_TIMED_EMITTER_THRESHOLD, manager, scheduler);
+        streamKey(), DEFAULT_TIMED_EMITTER_THRESHOLD, manager, timingWheel);
     auto handler = std::make_unique<LocalHandler<FileAttrChanged>>(m_handler);
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileAttrChanged>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileAttrChangedSubscription::toString() const
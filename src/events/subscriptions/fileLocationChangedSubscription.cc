@@ -30,17 +30,18 @@ StreamKey FileLocationChangedSubscription::streamKey() const
 }
 
 StreamPtr FileLocationChangedSubscription::createStream(Manager &manager,
-    SequencerManager & /*seqManager*/, Scheduler &scheduler) const
+    SequencerManager & /*seqManager*/, TimingWheel &timingWheel) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileLocationChanged>>();
     auto emitter = std::make_unique<TimedEmitter<FileLocationChanged>>(
-        streamKey(), DEFAULT_TIMED_EMITTER_THRESHOLD, manager, scheduler);
+        streamKey(), DEFAULT_TIMED_EMITTER_THRESHOLD, manager, timingWheel);
     auto handler =
         std::make_unique<LocalHandler<FileLocationChanged>>(m_handler);
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileLocationChanged>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileLocationChangedSubscription::toString() const
@@ -27,7 +27,7 @@ StreamKey FilePermChangedSubscription::streamKey() const
 }
 
 StreamPtr FilePermChangedSubscription::createStream(Manager & /*manager*/,
-    SequencerManager & /*seqManager*/, Scheduler & /*scheduler*/) const
+    SequencerManager & /*seqManager*/, TimingWheel & /*timingWheel*/) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FilePermChanged>>();
     auto emitter = std::make_unique<CounterEmitter<FilePermChanged>>(1);
@@ -35,7 +35,8 @@ StreamPtr FilePermChangedSubscription::createStream(Manager & /*manager*/,
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FilePermChanged>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FilePermChangedSubscription::toString() const
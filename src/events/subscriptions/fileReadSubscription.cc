@@ -7,7 +7,7 @@
  */
 
 #include "events/events.h"
-#include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include "messages.pb.h"
 
@@ -30,8 +30,8 @@ StreamKey FileReadSubscription::streamKey() const
     return StreamKey::FILE_READ;
 }
 
-StreamPtr FileReadSubscription::createStream(
-    Manager &manager, SequencerManager &seqManager, Scheduler &scheduler) const
+StreamPtr FileReadSubscription::createStream(Manager &manager,
+    SequencerManager &seqManager, TimingWheel &timingWheel) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileRead>>();
 
@@ -42,7 +42,7 @@ StreamPtr FileReadSubscription::createStream(
     }
     if (m_timeThreshold) {
         emitter = std::make_unique<TimedEmitter<FileRead>>(streamKey(),
-            m_timeThreshold.get(), manager, scheduler, std::move(emitter));
+            m_timeThreshold.get(), manager, timingWheel, std::move(emitter));
     }
 
     auto handler =
@@ -50,7 +50,8 @@ StreamPtr FileReadSubscription::createStream(
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileRead>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileReadSubscription::toString() const
@@ -27,7 +27,7 @@ StreamKey FileRemovedSubscription::streamKey() const
 }
 
 StreamPtr FileRemovedSubscription::createStream(Manager & /*manager*/,
-    SequencerManager & /*seqManager*/, Scheduler & /*scheduler*/) const
+    SequencerManager & /*seqManager*/, TimingWheel & /*timingWheel*/) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileRemoved>>();
     auto emitter = std::make_unique<CounterEmitter<FileRemoved>>(1);
@@ -35,7 +35,8 @@ StreamPtr FileRemovedSubscription::createStream(Manager & /*manager*/,
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileRemoved>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileRemovedSubscription::toString() const
@@ -39,10 +39,10 @@ public:
     /**
      * Creates a stream that handles each event separately without aggregation.
      * @see Subscription::createHandle(std::int64_t subscriptionId, Streams
-     * &streams, SequencerStream &stream)
+     * &streams, SubscriptionBatcher<> &batcher)
      */
     StreamPtr createStream(Manager &manager, SequencerManager &seqManager,
-        Scheduler &scheduler) const override;
+        TimingWheel &timingWheel) const override;
 
     std::string toString() const override;
 
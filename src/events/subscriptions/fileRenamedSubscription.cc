@@ -27,7 +27,7 @@ StreamKey FileRenamedSubscription::streamKey() const
 }
 
 StreamPtr FileRenamedSubscription::createStream(Manager & /*manager*/,
-    SequencerManager & /*seqManager*/, Scheduler & /*scheduler*/) const
+    SequencerManager & /*seqManager*/, TimingWheel & /*timingWheel*/) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileRenamed>>();
     auto emitter = std::make_unique<CounterEmitter<FileRenamed>>(1);
@@ -35,7 +35,8 @@ StreamPtr FileRenamedSubscription::createStream(Manager & /*manager*/,
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileRenamed>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileRenamedSubscription::toString() const
@@ -7,7 +7,7 @@
  */
 
 #include "events/events.h"
-#include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include "messages.pb.h"
 
@@ -30,8 +30,8 @@ StreamKey FileWrittenSubscription::streamKey() const
     return StreamKey::FILE_WRITTEN;
 }
 
-StreamPtr FileWrittenSubscription::createStream(
-    Manager &manager, SequencerManager &seqManager, Scheduler &scheduler) const
+StreamPtr FileWrittenSubscription::createStream(Manager &manager,
+    SequencerManager &seqManager, TimingWheel &timingWheel) const
 {
     auto aggregator = std::make_unique<KeyAggregator<FileWritten>>();
 
@@ -43,7 +43,7 @@ StreamPtr FileWrittenSubscription::createStream(
     }
     if (m_timeThreshold) {
         emitter = std::make_unique<TimedEmitter<FileWritten>>(streamKey(),
-            m_timeThreshold.get(), manager, scheduler, std::move(emitter));
+            m_timeThreshold.get(), manager, timingWheel, std::move(emitter));
     }
 
     auto handler =
@@ -51,7 +51,8 @@ StreamPtr FileWrittenSubscription::createStream(
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<FileWritten>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string FileWrittenSubscription::toString() const
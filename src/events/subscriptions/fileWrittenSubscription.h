@@ -43,10 +43,10 @@ public:
      * Creates a stream that aggregates event as long as counter or time
      * thresholds are not exceeded.
      * @see Subscription::createHandle(std::int64_t subscriptionId, Streams
-     * &streams, SequencerStream &stream)
+     * &streams, SubscriptionBatcher<> &batcher)
      */
     StreamPtr createStream(Manager &manager, SequencerManager &seqManager,
-        Scheduler &scheduler) const override;
+        TimingWheel &timingWheel) const override;
 
     std::string toString() const override;
 
@@ -26,7 +26,7 @@ StreamKey QuotaExceededSubscription::streamKey() const
 }
 
 StreamPtr QuotaExceededSubscription::createStream(Manager & /*manager*/,
-    SequencerManager & /*seqManager*/, Scheduler & /*scheduler*/) const
+    SequencerManager & /*seqManager*/, TimingWheel & /*timingWheel*/) const
 {
     auto aggregator = std::make_unique<KeyAggregator<QuotaExceeded>>();
     auto emitter = std::make_unique<CounterEmitter<QuotaExceeded>>(1);
@@ -34,7 +34,8 @@ StreamPtr QuotaExceededSubscription::createStream(Manager & /*manager*/,
 
     return std::make_unique<AsyncStream>(
         std::make_unique<TypedStream<QuotaExceeded>>(
-            std::move(aggregator), std::move(emitter), std::move(handler)));
+            std::move(aggregator), std::move(emitter), std::move(handler)),
+        streamKey());
 }
 
 std::string QuotaExceededSubscription::toString() const
@@ -15,10 +15,10 @@ namespace events {
 
 SubscriptionHandlePtr RemoteSubscription::createHandle(
     std::int64_t subscriptionId, Streams &streams,
-    SequencerStream &stream) const
+    SubscriptionBatcher<> &batcher) const
 {
     return std::make_unique<RemoteSubscriptionHandle>(
-        streamKey(), streams, subscriptionId, serialize(), stream);
+        streamKey(), streams, subscriptionId, serialize(), batcher);
 }
 
 } // namespace events
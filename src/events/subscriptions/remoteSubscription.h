@@ -27,10 +27,10 @@ public:
     /**
      * Creates a @c RemoteSubscriptionHandle instance.
      * @see Subscription::createHandle(std::int64_t subscriptionId, Streams
-     * &streams, SequencerStream &stream)
+     * &streams, SubscriptionBatcher<> &batcher)
      */
     SubscriptionHandlePtr createHandle(std::int64_t subscriptionId,
-        Streams &streams, SequencerStream &stream) const override;
+        Streams &streams, SubscriptionBatcher<> &batcher) const override;
 
     /**
      * Creates Protocol Buffers message based on provided @c RemoteSubscription.
@@ -8,8 +8,7 @@
 
 #include "remoteSubscriptionHandle.h"
 #include "helpers/logging.h"
-
-#include "messages.pb.h"
+#include "subscriptionBatcher.h"
 
 namespace one {
 namespace client {
@@ -17,28 +16,22 @@ namespace events {
 
 RemoteSubscriptionHandle::RemoteSubscriptionHandle(StreamKey streamKey,
     Streams &streams, std::int64_t subscriptionId, ProtoSubscriptionPtr msg,
-    SequencerStream &stream)
+    SubscriptionBatcher<> &batcher)
     : SubscriptionHandle(streamKey, streams)
     , m_subscriptionId{subscriptionId}
-    , m_stream{stream}
+    , m_batcher{batcher}
 {
-    LOG_DBG(2) << "Sending subscription with ID: '" << subscriptionId << "'";
+    LOG_DBG(2) << "Queuing subscription with ID: '" << subscriptionId << "'";
 
-    auto clientMsg = std::make_unique<ProtoClient>();
-    msg->set_id(m_subscriptionId);
-    clientMsg->mutable_subscription()->Swap(msg.release());
-    m_stream.send(std::move(clientMsg));
+    m_batcher.subscribe(m_subscriptionId, std::move(msg));
 }
 
 RemoteSubscriptionHandle::~RemoteSubscriptionHandle()
 {
-    LOG_DBG(2) << "Sending cancellation for subscription with ID: '"
+    LOG_DBG(2) << "Queuing cancellation for subscription with ID: '"
                << m_subscriptionId << "'";
 
-    auto clientMsg = std::make_unique<ProtoClient>();
-    auto msg = clientMsg->mutable_subscription_cancellation();
-    msg->set_id(m_subscriptionId);
-    m_stream.send(std::move(clientMsg));
+    m_batcher.cancel(m_subscriptionId);
 }
 
 } // namespace events
@@ -24,27 +24,27 @@ namespace events {
 class RemoteSubscriptionHandle : public SubscriptionHandle {
 public:
     /**
-     * Constructor. Sends subscription message to the remote producer.
+     * Constructor. Queues subscription message for the remote producer.
      * @param streamKey A key of a stream associated with the handle by a
      * subscription.
      * @param streams A collection of existing event streams.
      * @param subscriptionId An ID of a subscription associated with the handle.
      * @param msg A serialized subscription message that will be sent to the
      * remote producer.
-     * @param stream A @c SequencerStream instance.
+     * @param batcher A @c SubscriptionBatcher instance.
      */
     RemoteSubscriptionHandle(StreamKey streamKey, Streams &streams,
         std::int64_t subscriptionId, ProtoSubscriptionPtr msg,
-        SequencerStream &stream);
+        SubscriptionBatcher<> &batcher);
 
     /**
-     * Sends subscription cancellation to the remote producer.
+     * Queues subscription cancellation for the remote producer.
      */
     virtual ~RemoteSubscriptionHandle();
 
 private:
     std::int64_t m_subscriptionId;
-    SequencerStream &m_stream;
+    SubscriptionBatcher<> &m_batcher;
 };
 
 } // namespace events
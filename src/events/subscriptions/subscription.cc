@@ -15,7 +15,7 @@ namespace events {
 
 SubscriptionHandlePtr Subscription::createHandle(
     std::int64_t /*subscriptionId*/, Streams &streams,
-    SequencerStream & /*stream*/) const
+    SubscriptionBatcher<> & /*batcher*/) const
 {
     return std::make_unique<SubscriptionHandle>(streamKey(), streams);
 }
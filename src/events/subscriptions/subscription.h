@@ -38,11 +38,12 @@ public:
      * subscription.
      * @param manager A @c Manager instance.
      * @param seqManager A @c SequencerManager instance.
-     * @param scheduler A @c Scheduler instance.
+     * @param timingWheel A @c TimingWheel instance used to schedule periodic
+     * stream flushes.
      * @return A created @c Stream instance.
      */
     virtual StreamPtr createStream(Manager &manager,
-        SequencerManager &seqManager, Scheduler &scheduler) const = 0;
+        SequencerManager &seqManager, TimingWheel &timingWheel) const = 0;
 
     /**
      * Creates a handle responsible for deletion of the event stream when the
@@ -51,11 +52,11 @@ public:
      * @param subscriptionId An ID of a subscription associated with this
      * handle.
      * @param streams A collection of existing event streams.
-     * @param stream An @c SequencerStream instance.
+     * @param batcher An @c SubscriptionBatcher instance.
      * @return A @c SubscriptionHandle instance.
      */
     virtual SubscriptionHandlePtr createHandle(std::int64_t subscriptionId,
-        Streams &streams, SequencerStream &stream) const;
+        Streams &streams, SubscriptionBatcher<> &batcher) const;
 
     /**
      * Provides a human-readable subscription description.
@@ -0,0 +1,240 @@
+/**
+ * @file subscriptionBatcher.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#ifndef ONECLIENT_EVENTS_SUBSCRIPTIONS_SUBSCRIPTION_BATCHER_H
+#define ONECLIENT_EVENTS_SUBSCRIPTIONS_SUBSCRIPTION_BATCHER_H
+
+#include "events/declarations.h"
+#include "helpers/logging.h"
+#include "monitoring/monitoring.h"
+
+#include "messages.pb.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace events {
+
+/**
+ * @c SubscriptionBatcher is responsible for sending subscription and
+ * subscription cancellation messages to the remote producer in batches.
+ * Messages are queued and sent together once per batch interval, measured
+ * since the first message queued after the last send. A subscription which
+ * is cancelled before it has been sent is dropped along with its
+ * cancellation, so short-lived cache entries do not generate any traffic.
+ */
+template <class Scheduler> class SubscriptionBatcher {
+public:
+    /**
+     * Constructor.
+     * @param send A function sending a single message to the remote producer.
+     * @param scheduler A @c Scheduler instance used to schedule sending of
+     * queued messages.
+     * @param interval A period, measured since the first message queued after
+     * the last send, after which queued messages are sent. Messages are sent
+     * immediately if the interval is zero.
+     */
+    SubscriptionBatcher(std::function<void(ProtoClientPtr)> send,
+        Scheduler &scheduler,
+        std::chrono::milliseconds interval =
+            DEFAULT_SUBSCRIPTION_BATCH_INTERVAL);
+
+    /**
+     * Destructor. Cancels the scheduled send, waits for a send already
+     * started by the scheduler and sends queued messages.
+     */
+    ~SubscriptionBatcher();
+
+    /**
+     * Queues a subscription message.
+     * @param subscriptionId An ID of the subscription.
+     * @param msg A serialized subscription message.
+     */
+    void subscribe(std::int64_t subscriptionId, ProtoSubscriptionPtr msg);
+
+    /**
+     * Queues a subscription cancellation message, or drops the subscription
+     * message if it has not been sent yet.
+     * @param subscriptionId An ID of the subscription.
+     */
+    void cancel(std::int64_t subscriptionId);
+
+    /**
+     * Sends all queued messages.
+     */
+    void flush();
+
+private:
+    /**
+     * State shared with the scheduled sends, which outlives the batcher.
+     * A send runs only while the batcher is alive, with the mutex held.
+     */
+    struct FlushGuard {
+        std::mutex mutex;
+        bool alive = true;
+    };
+
+    void scheduleFlush();
+
+    std::function<void(ProtoClientPtr)> m_send;
+    Scheduler &m_scheduler;
+    const std::chrono::milliseconds m_interval;
+
+    std::mutex m_mutex;
+    // Queued messages, dropped subscriptions are left as empty pointers
+    std::vector<ProtoClientPtr> m_messages;
+    // Positions of queued subscription messages by subscription ID
+    std::unordered_map<std::int64_t, std::size_t> m_pendingSubscriptions;
+    bool m_flushScheduled = false;
+    std::function<void()> m_cancelFlush = [] {};
+    std::shared_ptr<FlushGuard> m_flushGuard = std::make_shared<FlushGuard>();
+};
+
+template <class Scheduler>
+SubscriptionBatcher<Scheduler>::SubscriptionBatcher(
+    std::function<void(ProtoClientPtr)> send, Scheduler &scheduler,
+    std::chrono::milliseconds interval)
+    : m_send{std::move(send)}
+    , m_scheduler{scheduler}
+    , m_interval{interval}
+{
+}
+
+template <class Scheduler>
+SubscriptionBatcher<Scheduler>::~SubscriptionBatcher()
+{
+    {
+        std::lock_guard<std::mutex> guard{m_flushGuard->mutex};
+        m_flushGuard->alive = false;
+    }
+
+    std::function<void()> cancelFlush = [] {};
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        std::swap(cancelFlush, m_cancelFlush);
+    }
+
+    cancelFlush();
+    flush();
+}
+
+template <class Scheduler>
+void SubscriptionBatcher<Scheduler>::subscribe(
+    std::int64_t subscriptionId, ProtoSubscriptionPtr msg)
+{
+    LOG_FCALL() << LOG_FARG(subscriptionId);
+
+    auto clientMsg = std::make_unique<ProtoClient>();
+    msg->set_id(subscriptionId);
+    clientMsg->mutable_subscription()->Swap(msg.get());
+
+    if (m_interval.count() == 0) {
+        m_send(std::move(clientMsg));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_pendingSubscriptions[subscriptionId] = m_messages.size();
+        m_messages.emplace_back(std::move(clientMsg));
+    }
+
+    scheduleFlush();
+}
+
+template <class Scheduler>
+void SubscriptionBatcher<Scheduler>::cancel(std::int64_t subscriptionId)
+{
+    LOG_FCALL() << LOG_FARG(subscriptionId);
+
+    auto clientMsg = std::make_unique<ProtoClient>();
+    clientMsg->mutable_subscription_cancellation()->set_id(subscriptionId);
+
+    if (m_interval.count() == 0) {
+        m_send(std::move(clientMsg));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        auto it = m_pendingSubscriptions.find(subscriptionId);
+        if (it != m_pendingSubscriptions.end()) {
+            LOG_DBG(2) << "Dropping subscription with ID: '" << subscriptionId
+                       << "' cancelled before it has been sent";
+
+            m_messages[it->second].reset();
+            m_pendingSubscriptions.erase(it);
+            ONE_METRIC_COUNTER_INC(
+                "comp.oneclient.mod.events.submod.subscriptions.dropped");
+            return;
+        }
+
+        m_messages.emplace_back(std::move(clientMsg));
+    }
+
+    scheduleFlush();
+}
+
+template <class Scheduler> void SubscriptionBatcher<Scheduler>::flush()
+{
+    LOG_FCALL();
+
+    std::vector<ProtoClientPtr> messages;
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        std::swap(messages, m_messages);
+        m_pendingSubscriptions.clear();
+        m_flushScheduled = false;
+    }
+
+    LOG_DBG(2) << "Sending batch of " << messages.size()
+               << " subscription messages";
+
+    for (auto &msg : messages) {
+        if (msg)
+            m_send(std::move(msg));
+    }
+}
+
+template <class Scheduler> void SubscriptionBatcher<Scheduler>::scheduleFlush()
+{
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        if (m_flushScheduled)
+            return;
+
+        m_flushScheduled = true;
+    }
+
+    // The task may run before schedule returns, so the mutex is not held
+    auto cancelFlush = m_scheduler.schedule(m_interval,
+        [ this, weakFlushGuard = std::weak_ptr<FlushGuard>{m_flushGuard} ] {
+            auto flushGuard = weakFlushGuard.lock();
+            if (!flushGuard)
+                return;
+
+            std::lock_guard<std::mutex> guard{flushGuard->mutex};
+            if (flushGuard->alive)
+                this->flush();
+        });
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+    m_cancelFlush = std::move(cancelFlush);
+}
+
+} // namespace events
+} // namespace client
+} // namespace one
+
+#endif // ONECLIENT_EVENTS_SUBSCRIPTIONS_SUBSCRIPTION_BATCHER_H
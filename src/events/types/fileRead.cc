@@ -27,6 +27,16 @@ FileRead::FileRead(std::string fileUuid, off_t offset, size_t size,
 {
 }
 
+FileRead::FileRead(std::string fileUuid,
+    boost::icl::discrete_interval<off_t> block, std::size_t size,
+    std::size_t counter)
+    : m_counter{counter}
+    , m_fileUuid{std::move(fileUuid)}
+    , m_size{size}
+    , m_blocks{{block, FileBlock{}}}
+{
+}
+
 StreamKey FileRead::streamKey() const { return StreamKey::FILE_READ; }
 
 const AggregationKey &FileRead::aggregationKey() const { return m_fileUuid; }
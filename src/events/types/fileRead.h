@@ -40,6 +40,17 @@ public:
     FileRead(std::string fileUuid, off_t offset, std::size_t size,
         std::string storageId = {}, std::string fileId = {});
 
+    /**
+     * Constructor.
+     * @param fileUuid UUID of a file associated with the read operations.
+     * @param block Range of the file covered by the read operations.
+     * @param size Total number of bytes read, which exceeds the size of the
+     * block when parts of it were read repeatedly.
+     * @param counter Number of read operations represented by the event.
+     */
+    FileRead(std::string fileUuid, boost::icl::discrete_interval<off_t> block,
+        std::size_t size, std::size_t counter);
+
     StreamKey streamKey() const override;
 
     /**
@@ -158,6 +158,7 @@ void FsSubscriptions::handlePermissionChanged(
     m_runInFiber([ this, events = std::move(events) ] {
         for (auto &event : events) {
             m_forceProxyIOCache.remove(event->fileUuid());
+            m_onPermissionChanged(event->fileUuid());
         }
     });
 }
@@ -260,6 +261,90 @@ bool FsSubscriptions::unsubscribeFileRenamed(const folly::fbstring &fileUuid)
     return unsubscribe(events::StreamKey::FILE_RENAMED, fileUuid);
 }
 
+void FsSubscriptions::subscribeDirectoryScoped(
+    const folly::fbstring &fileUuid, const folly::fbstring &parentUuid)
+{
+    LOG_FCALL() << LOG_FARG(fileUuid) << LOG_FARG(parentUuid);
+
+    const auto &scopeUuid = parentUuid.empty() ? fileUuid : parentUuid;
+
+    std::lock_guard<std::mutex> guard{m_directoryScopesMutex};
+    if (!m_directoryScopes.emplace(fileUuid, scopeUuid).second)
+        return;
+
+    acquireDirectoryScope(scopeUuid);
+}
+
+bool FsSubscriptions::unsubscribeDirectoryScoped(
+    const folly::fbstring &fileUuid)
+{
+    LOG_FCALL() << LOG_FARG(fileUuid);
+
+    std::lock_guard<std::mutex> guard{m_directoryScopesMutex};
+    auto it = m_directoryScopes.find(fileUuid);
+    if (it == m_directoryScopes.end())
+        return false;
+
+    const auto scopeUuid = std::move(it->second);
+    m_directoryScopes.erase(it);
+
+    releaseDirectoryScope(scopeUuid);
+    return true;
+}
+
+void FsSubscriptions::renameDirectoryScoped(const folly::fbstring &oldUuid,
+    const folly::fbstring &newUuid, const folly::fbstring &newParentUuid)
+{
+    LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid)
+                << LOG_FARG(newParentUuid);
+
+    const auto &newScopeUuid = newParentUuid.empty() ? newUuid : newParentUuid;
+
+    std::lock_guard<std::mutex> guard{m_directoryScopesMutex};
+    auto it = m_directoryScopes.find(oldUuid);
+    if (it == m_directoryScopes.end())
+        return;
+
+    const auto oldScopeUuid = std::move(it->second);
+    m_directoryScopes.erase(it);
+
+    // The rename target may already be covered by its own subscriptions
+    if (m_directoryScopes.emplace(newUuid, newScopeUuid).second)
+        acquireDirectoryScope(newScopeUuid);
+
+    // The new scope is acquired first, so that subscriptions of a directory
+    // are not recreated when a file is renamed within it
+    releaseDirectoryScope(oldScopeUuid);
+}
+
+void FsSubscriptions::acquireDirectoryScope(const folly::fbstring &scopeUuid)
+{
+    if (m_directoryScopeRefs[scopeUuid]++ > 0)
+        return;
+
+    LOG_DBG(2) << "Subscribing for directory " << scopeUuid;
+
+    subscribeFileAttrChanged(scopeUuid);
+    subscribeFileRemoved(scopeUuid);
+    subscribeFileRenamed(scopeUuid);
+}
+
+void FsSubscriptions::releaseDirectoryScope(const folly::fbstring &scopeUuid)
+{
+    auto refIt = m_directoryScopeRefs.find(scopeUuid);
+    assert(refIt != m_directoryScopeRefs.end());
+    if (--refIt->second > 0)
+        return;
+
+    m_directoryScopeRefs.erase(refIt);
+
+    LOG_DBG(2) << "Unsubscribing for directory " << scopeUuid;
+
+    unsubscribeFileAttrChanged(scopeUuid);
+    unsubscribeFileRemoved(scopeUuid);
+    unsubscribeFileRenamed(scopeUuid);
+}
+
 void FsSubscriptions::subscribe(
     const folly::fbstring &fileUuid, const events::Subscription &subscription)
 {
@@ -9,6 +9,7 @@
 #include "fsLogic.h"
 
 #include "communication/communicator.h"
+#include "communication/exception.h"
 #include "context.h"
 #include "helpers/logging.h"
 #include "messages/configuration.h"
@@ -49,6 +50,7 @@
 #include "messages/fuse/xattrList.h"
 #include "monitoring/monitoring.h"
 #include "util/cdmi.h"
+#include "util/timingWheel.h"
 #include "util/xattrHelper.h"
 //#include "webDAVHelper.h"
 
@@ -60,10 +62,16 @@
 #include <folly/fibers/Baton.h>
 #include <folly/fibers/FiberManager.h>
 #include <folly/fibers/ForEach.h>
+#include <folly/fibers/TimedMutex.h>
 #include <folly/json.h>
 #include <fuse/fuse_lowlevel.h>
 #include <openssl/md4.h>
 
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <vector>
+
 #include "buffering/bufferAgent.h"
 
 #define IOTRACE_START() auto __ioTraceStart = std::chrono::system_clock::now();
@@ -105,6 +113,42 @@ inline helpers::Flag getOpenFlag(const helpers::FlagsSet &flagsSet)
 
 constexpr auto XATTR_FILE_BLOCKS_MAP_LENGTH = 50;
 
+// Open flags requiring written data to reach the storage before the write
+// returns
+#if defined(O_DIRECT)
+constexpr auto WRITE_THROUGH_FLAGS = O_SYNC | O_DSYNC | O_DIRECT;
+#else
+constexpr auto WRITE_THROUGH_FLAGS = O_SYNC | O_DSYNC;
+#endif
+
+// Checks whether an error of a helper operation indicates a problem with
+// the storage, rather than with the request
+inline bool isStorageFailure(const std::error_code &ec)
+{
+    switch (ec.value()) {
+        case EAGAIN:
+        case EIO:
+        case ETIMEDOUT:
+        case ECONNREFUSED:
+        case ECONNRESET:
+        case ECONNABORTED:
+        case EHOSTUNREACH:
+        case ENETUNREACH:
+        case ENETDOWN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Number of bytes transferred by a helper operation
+inline std::size_t transferredBytes(const folly::IOBufQueue &buf)
+{
+    return buf.empty() ? 0 : buf.front()->computeChainDataLength();
+}
+
+inline std::size_t transferredBytes(const std::size_t bytes) { return bytes; }
+
 inline static folly::fbstring ONE_XATTR(std::string name)
 {
     assert(!name.empty());
@@ -119,8 +163,16 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     std::function<void(folly::Function<void()>)> runInFiber)
     : m_context{context}
     , m_metadataCache{*m_context->communicator(), metadataCacheSize,
-          providerTimeout}
+          providerTimeout,
+          m_context->options()->isMetadataCacheClockEnabled()}
     , m_helpersCache{std::move(helpersCache)}
+    , m_helperHandlePool{m_context->options()->getHelperHandlePoolSize(),
+          FSLOGIC_HELPER_HANDLE_POOL_GRACE_PERIOD}
+    , m_storageHealth{
+          m_context->options()->getStorageCircuitBreakerThreshold()}
+    , m_ioPathSelector{m_context->options()->isDirectIOForced()
+              ? 0.0
+              : m_context->options()->getIOPathProbeRatio()}
     , m_readdirCache{std::make_shared<cache::ReaddirCache>(
           m_metadataCache, m_context, configuration->rootUuid(), runInFiber)}
     , m_readEventsDisabled{readEventsDisabled}
@@ -150,6 +202,17 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     , m_ioTraceLoggerEnabled{m_context->options()->isIOTraceLoggerEnabled()}
     , m_tagOnCreate{m_context->options()->getOnCreateTag()}
     , m_tagOnModify{m_context->options()->getOnModifyTag()}
+    , m_writeExtentBatchSize{m_context->options()->getWriteExtentBatchSize()}
+    , m_maxAsyncReleases{m_context->options()->getMaxAsyncReleases()}
+    , m_fsyncOnRelease{m_context->options()->isFsyncOnReleaseEnabled()}
+    , m_writeBackDirectory{m_context->options()->getWriteBackDirPath()}
+    , m_writeBackFileDirtyLimit{
+          m_context->options()->getWriteBackFileDirtyLimit()}
+    , m_writeBackDirtyLimit{m_context->options()->getWriteBackDirtyLimit()}
+    , m_writeBackOnFlush{
+          m_context->options()->getWriteBackDurability() == "close"}
+    , m_directorySubscriptions{
+          m_context->options()->areDirectorySubscriptionsEnabled()}
     , m_rootUuid{configuration->rootUuid()}
 /* clang-format on */
 {
@@ -168,22 +231,54 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
         }});
     disableSpaces(configuration->disabledSpaces());
 
+    // FilePermChanged subscription of a file is shared by the force proxy IO
+    // cache and the helper handle pool
     m_forceProxyIOCache.onAdd([this](const folly::fbstring &uuid) {
-        m_fsSubscriptions.subscribeFilePermChanged(uuid);
+        if (!m_helperHandlePool.contains(uuid))
+            m_fsSubscriptions.subscribeFilePermChanged(uuid);
     });
 
     m_forceProxyIOCache.onRemove([this](const folly::fbstring &uuid) {
-        m_fsSubscriptions.unsubscribeFilePermChanged(uuid);
+        if (!m_helperHandlePool.contains(uuid))
+            m_fsSubscriptions.unsubscribeFilePermChanged(uuid);
     });
 
-    m_metadataCache.onAdd([this](const folly::fbstring &uuid) {
-        m_fsSubscriptions.subscribeFileAttrChanged(uuid);
-        m_fsSubscriptions.subscribeFileRemoved(uuid);
-        m_fsSubscriptions.subscribeFileRenamed(uuid);
+    m_helperHandlePool.onEvict([this](const folly::fbstring &uuid,
+                                   helpers::FileHandlePtr helperHandle) {
+        if (!m_helperHandlePool.contains(uuid) &&
+            !m_forceProxyIOCache.contains(uuid))
+            m_fsSubscriptions.unsubscribeFilePermChanged(uuid);
+
+        helperHandle->release().then(
+            [uuid, helperHandle](folly::Try<folly::Unit> &&t) {
+                if (t.hasException())
+                    LOG(WARNING) << "Release of pooled helper handle of file "
+                                 << uuid
+                                 << " failed: " << t.exception().what();
+            });
+    });
+
+    m_fsSubscriptions.onPermissionChanged([this](const folly::fbstring &uuid) {
+        m_helperHandlePool.invalidate(uuid);
     });
 
+    m_metadataCache.onAdd(
+        [this](const folly::fbstring &uuid, const folly::fbstring &parentUuid) {
+            if (m_directorySubscriptions) {
+                m_fsSubscriptions.subscribeDirectoryScoped(uuid, parentUuid);
+                return;
+            }
+
+            m_fsSubscriptions.subscribeFileAttrChanged(uuid);
+            m_fsSubscriptions.subscribeFileRemoved(uuid);
+            m_fsSubscriptions.subscribeFileRenamed(uuid);
+        });
+
     m_metadataCache.onOpen([this](const folly::fbstring &uuid) {
-        m_fsSubscriptions.subscribeFileAttrChanged(uuid);
+        // With directory subscriptions attributes of open files are updated
+        // through the subscription covering the file
+        if (!m_directorySubscriptions)
+            m_fsSubscriptions.subscribeFileAttrChanged(uuid);
         m_fsSubscriptions.subscribeFileLocationChanged(uuid);
     });
 
@@ -192,29 +287,45 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     });
 
     m_metadataCache.onPrune([this](const folly::fbstring &uuid) {
-        m_fsSubscriptions.unsubscribeFileAttrChanged(uuid);
         m_fsSubscriptions.unsubscribeFileLocationChanged(uuid);
+
+        if (m_directorySubscriptions) {
+            m_fsSubscriptions.unsubscribeDirectoryScoped(uuid);
+            return;
+        }
+
+        m_fsSubscriptions.unsubscribeFileAttrChanged(uuid);
         m_fsSubscriptions.unsubscribeFileRemoved(uuid);
         m_fsSubscriptions.unsubscribeFileRenamed(uuid);
     });
 
-    m_metadataCache.onRename(
-        [this](const folly::fbstring &oldUuid, const folly::fbstring &newUuid) {
-            m_fsSubscriptions.unsubscribeFileAttrChanged(oldUuid);
-            m_fsSubscriptions.unsubscribeFileRemoved(oldUuid);
-            m_fsSubscriptions.unsubscribeFileRenamed(oldUuid);
-            m_fsSubscriptions.subscribeFileAttrChanged(newUuid);
-            m_fsSubscriptions.subscribeFileRemoved(newUuid);
-            m_fsSubscriptions.subscribeFileRenamed(newUuid);
+    m_metadataCache.onRename([this](const folly::fbstring &oldUuid,
+        const folly::fbstring &newUuid, const folly::fbstring &newParentUuid) {
+            if (m_directorySubscriptions) {
+                m_fsSubscriptions.renameDirectoryScoped(
+                    oldUuid, newUuid, newParentUuid);
+            }
+            else {
+                m_fsSubscriptions.unsubscribeFileAttrChanged(oldUuid);
+                m_fsSubscriptions.unsubscribeFileRemoved(oldUuid);
+                m_fsSubscriptions.unsubscribeFileRenamed(oldUuid);
+                m_fsSubscriptions.subscribeFileAttrChanged(newUuid);
+                m_fsSubscriptions.subscribeFileRemoved(newUuid);
+                m_fsSubscriptions.subscribeFileRenamed(newUuid);
+            }
 
             if (m_fsSubscriptions.unsubscribeFileLocationChanged(oldUuid))
                 m_fsSubscriptions.subscribeFileLocationChanged(newUuid);
 
+            m_helperHandlePool.invalidate(oldUuid);
+
             m_onRename(oldUuid, newUuid);
         });
 
-    m_metadataCache.onMarkDeleted(
-        [this](const folly::fbstring &uuid) { m_onMarkDeleted(uuid); });
+    m_metadataCache.onMarkDeleted([this](const folly::fbstring &uuid) {
+        m_helperHandlePool.invalidate(uuid);
+        m_onMarkDeleted(uuid);
+    });
 
     if (m_clusterPrefetchThresholdRandom) {
         m_clusterPrefetchDistribution = std::uniform_int_distribution<int>(
@@ -227,9 +338,42 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
             configuration->rootUuid(), 0,
             context->options()->getMountpoint().string());
     }
+
+    if (m_context->options()->isStorageDetectionOnMountEnabled() &&
+        !m_context->options()->isProxyIOForced())
+        guardedRunInFiber()([this] { detectStorages(); });
+
+    if (auto manifestPath =
+            m_context->options()->getMetadataWarmupManifestPath())
+        guardedRunInFiber()([ this, manifestPath = *manifestPath ] {
+            warmupMetadata(manifestPath);
+        });
 }
 
-FsLogic::~FsLogic() { m_context->communicator()->stop(); }
+FsLogic::~FsLogic()
+{
+    {
+        std::lock_guard<std::mutex> guard{m_liveness->mutex};
+        m_liveness->alive = false;
+    }
+
+    // Background releases have to reach the provider before the communicator
+    // is stopped, their file handles are destroyed along with this object
+    for (auto &asyncRelease : m_asyncReleases)
+        asyncRelease.second.future.wait(m_providerTimeout);
+
+    // The same applies to the releases of pooled helper handles
+    std::vector<folly::Future<folly::Unit>> pooledReleases;
+    m_helperHandlePool.onEvict(
+        [&](const folly::fbstring &, helpers::FileHandlePtr helperHandle) {
+            pooledReleases.emplace_back(helperHandle->release().then(
+                [helperHandle](folly::Try<folly::Unit> &&) {}));
+        });
+    m_helperHandlePool.clear();
+    folly::collectAll(pooledReleases).wait(m_providerTimeout);
+
+    m_context->communicator()->stop();
+}
 
 FileAttrPtr FsLogic::lookup(
     const folly::fbstring &uuid, const folly::fbstring &name)
@@ -297,10 +441,12 @@ std::uint64_t FsLogic::open(const folly::fbstring &uuid, const int flags)
 
     const auto fuseFileHandleId = m_nextFuseHandleId++;
 
-    m_fuseFileHandles.emplace(fuseFileHandleId,
-        std::make_shared<FuseFileHandle>(filteredFlags, opened.handleId(),
-            openFileToken, *m_helpersCache, m_forceProxyIOCache,
-            m_providerTimeout, m_randomReadPrefetchEvaluationFrequency));
+    auto fuseFileHandle = std::make_shared<FuseFileHandle>(filteredFlags,
+        opened.handleId(), openFileToken, *m_helpersCache, m_forceProxyIOCache,
+        m_providerTimeout, m_randomReadPrefetchEvaluationFrequency);
+    fuseFileHandle->setHelperHandlePool(&m_helperHandlePool);
+
+    m_fuseFileHandles.emplace(fuseFileHandleId, std::move(fuseFileHandle));
 
     IOTRACE_END(
         IOTraceOpen, IOTraceLogger::OpType::OPEN, uuid, fuseFileHandleId, flags)
@@ -327,42 +473,137 @@ void FsLogic::release(
 
     auto fuseFileHandle = m_fuseFileHandles.at(fileHandleId);
 
-    fsync(uuid, fileHandleId, false);
+    // Release is not synchronous with close(2), so the write-back journal is
+    // always drained here, regardless of the durability mode. The handle is
+    // released anyway and the upload error is returned afterwards.
+    std::exception_ptr writeBackError;
+    try {
+        uploadWriteBackJournal(fuseFileHandle);
+    }
+    catch (const std::exception &e) {
+        LOG(ERROR) << "Uploading write-back journal of file " << uuid
+                   << " failed: " << e.what();
+        writeBackError = std::current_exception();
+    }
+
+    if (fuseFileHandle->writeBackJournal() != nullptr) {
+        m_writeBackDirtySize -= fuseFileHandle->writeBackJournal()->dirtySize();
+        ONE_METRIC_COUNTER_SET(
+            "comp.oneclient.mod.fslogic.writeback.dirty", m_writeBackDirtySize);
 
-    folly::fbvector<folly::Future<folly::Unit>> releaseFutures;
-    for (auto &helperHandle : fuseFileHandle->helperHandles())
-        releaseFutures.emplace_back(helperHandle->release());
+        auto owner = m_writeBackHandleIds.find(uuid);
+        if (owner != m_writeBackHandleIds.end() &&
+            owner->second == fileHandleId)
+            m_writeBackHandleIds.erase(owner);
+    }
 
-    auto releaseExceptionFuture =
-        folly::collectAll(releaseFutures)
-            .then([](const std::vector<folly::Try<folly::Unit>> &tries) {
-                for (auto &t : tries)
-                    t.value();
+    publishPendingWrite(fuseFileHandle);
+    publishPendingRead(fuseFileHandle);
+
+    m_eventManager.flush(uuid.toStdString());
+
+    auto releaseFuture = releaseFileHandle(uuid, fuseFileHandle);
+
+    m_fuseFileHandles.erase(fileHandleId);
+
+    if (m_asyncReleases.size() < m_maxAsyncReleases) {
+        LOG_DBG(2) << "Completing release of file " << uuid
+                   << " in background";
+
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fslogic.asyncreleases");
+
+        auto onReleased = [
+            this, uuid, fileHandleId, runInFiber = guardedRunInFiber()
+        ](folly::Try<folly::Unit> && t) mutable
+        {
+            if (t.hasException())
+                LOG(WARNING) << "Asynchronous release of file " << uuid
+                             << " failed: " << t.exception().what();
+
+            // Open file token has to be released in the fslogic fiber
+            runInFiber([this, fileHandleId] {
+                m_asyncReleases.erase(fileHandleId);
+                ONE_METRIC_COUNTER_DEC(
+                    "comp.oneclient.mod.fslogic.asyncreleases");
             });
+        };
+
+        m_asyncReleases.emplace(fileHandleId,
+            AsyncRelease{std::move(fuseFileHandle),
+                releaseFuture.within(m_providerTimeout)
+                    .then(std::move(onReleased))});
+
+        if (writeBackError)
+            std::rethrow_exception(writeBackError);
+
+        return;
+    }
 
-    std::exception_ptr releaseException;
     try {
-        communication::wait(releaseExceptionFuture, m_providerTimeout);
+        communication::wait(releaseFuture, m_providerTimeout);
     }
     catch (const std::exception &e) {
         LOG(WARNING) << "File release failed: " << e.what();
-        releaseException = std::current_exception();
-    }
-    catch (...) {
-        LOG(WARNING) << "File release failed: unknown error";
-        releaseException = std::current_exception();
+        throw;
     }
 
-    LOG_DBG(2) << "Sending file release message for " << uuid;
+    if (writeBackError)
+        std::rethrow_exception(writeBackError);
+}
 
-    communicate(messages::fuse::Release{uuid.toStdString(),
-                    fuseFileHandle->providerHandleId()->toStdString()},
-        m_providerTimeout);
+folly::Future<folly::Unit> FsLogic::releaseFileHandle(
+    const folly::fbstring &uuid,
+    const std::shared_ptr<FuseFileHandle> &fuseFileHandle)
+{
+    const auto providerHandleId =
+        fuseFileHandle->providerHandleId()->toStdString();
+
+    // Provider fsync and release of each helper handle are independent, so
+    // they are performed concurrently
+    folly::fbvector<folly::Future<folly::Unit>> futures;
+    if (m_fsyncOnRelease) {
+        LOG_DBG(2) << "Sending file fsync message for " << uuid;
+
+        futures.emplace_back(
+            communicateAsync(messages::fuse::FSync{uuid.toStdString(), false,
+                                 providerHandleId},
+                m_providerTimeout)
+                .then([](messages::fuse::FuseResponse &&) {}));
+    }
 
-    m_fuseFileHandles.erase(fileHandleId);
+    // Pooled helper handles are only flushed, so that subsequent opens of
+    // the file can reuse them. The file is already subscribed for permission
+    // changes if any of its handles is pooled or it is forced to proxy IO.
+    const bool permChangedSubscribed = m_helperHandlePool.contains(uuid) ||
+        m_forceProxyIOCache.contains(uuid);
+    auto pooledHandles = fuseFileHandle->poolHelperHandles(uuid);
+    if (!pooledHandles.empty()) {
+        if (!permChangedSubscribed)
+            m_fsSubscriptions.subscribeFilePermChanged(uuid);
+        scheduleHelperHandlePoolPrune();
+    }
+
+    for (auto &helperHandle : pooledHandles)
+        futures.emplace_back(helperHandle->fsync(false));
 
-    if (releaseException)
-        std::rethrow_exception(releaseException);
+    for (auto &helperHandle : fuseFileHandle->helperHandles())
+        futures.emplace_back(helperHandle->fsync(false).then(
+            [helperHandle] { return helperHandle->release(); }));
+
+    // Provider handle can be released only after helper handles, which may
+    // still use it in proxy mode
+    return folly::collectAll(futures).then([
+        this, uuid = uuid.toStdString(), providerHandleId
+    ](std::vector<folly::Try<folly::Unit>> && tries) {
+        LOG_DBG(2) << "Sending file release message for " << uuid;
+
+        return communicateAsync(
+            messages::fuse::Release{uuid, providerHandleId}, m_providerTimeout)
+            .then([tries = std::move(tries)](messages::fuse::FuseResponse &&) {
+                for (auto &t : tries)
+                    t.value();
+            });
+    });
 }
 
 void FsLogic::flush(
@@ -375,6 +616,12 @@ void FsLogic::flush(
 
     auto fuseFileHandle = m_fuseFileHandles.at(fileHandleId);
 
+    if (m_writeBackOnFlush)
+        uploadWriteBackJournal(fuseFileHandle);
+
+    publishPendingWrite(fuseFileHandle);
+    publishPendingRead(fuseFileHandle);
+
     LOG_DBG(2) << "Sending file flush message for " << uuid;
 
     for (auto &helperHandle : fuseFileHandle->helperHandles())
@@ -390,10 +637,15 @@ void FsLogic::fsync(const folly::fbstring &uuid,
     IOTRACE_GUARD(IOTraceFsync, IOTraceLogger::OpType::FSYNC, uuid,
         fileHandleId, dataOnly)
 
-    m_eventManager.flush();
-
     auto fuseFileHandle = m_fuseFileHandles.at(fileHandleId);
 
+    uploadWriteBackJournal(fuseFileHandle);
+
+    publishPendingWrite(fuseFileHandle);
+    publishPendingRead(fuseFileHandle);
+
+    m_eventManager.flush(uuid.toStdString());
+
     LOG_DBG(2) << "Sending file fsync message for " << uuid;
 
     communicate(messages::fuse::FSync{uuid.toStdString(), dataOnly,
@@ -428,6 +680,12 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
     }
 
     auto fuseFileHandle = m_fuseFileHandles.at(fileHandleId);
+
+    // Make sure the reads see writes journaled through all handles of the
+    // file and the writes pending in this handle
+    uploadWriteBackJournals(uuid);
+    publishPendingWrite(fuseFileHandle);
+
     auto attr = m_metadataCache.getAttr(uuid);
 
     const auto fileSize = *attr->size();
@@ -447,12 +705,20 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
 
     LOG_DBG(2) << "Reading from file " << uuid << " from range " << wantedRange;
 
+    // Storage of the read block, if it has been determined
+    folly::fbstring storageId;
+
     // Even if several "touching" blocks with different helpers are
     // available to read right now, for simplicity we'll only read a single
     // block per a read operation.
     try {
         auto locationData = m_metadataCache.getBlock(uuid, offset);
         if (!locationData.hasValue()) {
+            if (publishPendingWrites(uuid)) {
+                return read(uuid, fileHandleId, offset, size,
+                    std::move(checksum), retriesLeft, std::move(ioTraceEntry));
+            }
+
             LOG_DBG(2) << "Requested block for " << uuid
                        << " not yet replicated - fetching from remote provider";
 
@@ -497,9 +763,12 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         const std::size_t availableSize =
             boost::icl::size(wantedAvailableRange);
 
-        auto helperHandle = fuseFileHandle->getHelperHandle(uuid,
-            m_metadataCache.getSpaceId(uuid), fileBlock.storageId(),
-            fileBlock.fileId());
+        storageId = fileBlock.storageId();
+
+        helpers::FileHandlePtr helperHandle;
+        folly::Optional<IOPath> ioPath;
+        std::tie(helperHandle, ioPath) = getStorageHelperHandle(
+            fuseFileHandle, uuid, m_metadataCache.getSpaceId(uuid), fileBlock);
 
         if (checksum) {
             LOG_DBG(1) << "Waiting on helper flush for " << uuid
@@ -524,9 +793,8 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         LOG_DBG(2) << "Reading " << availableSize << " bytes from " << uuid
                    << " at offset " << offset;
 
-        auto readBuffer = communication::wait(
-            helperHandle->read(offset, availableSize, continuousSize),
-            helperHandle->timeout());
+        auto readBuffer = waitForStorage(storageId, ioPath, helperHandle,
+            helperHandle->read(offset, availableSize, continuousSize));
 
         if (helperHandle->needsDataConsistencyCheck() && checksum &&
             dataCorrupted(uuid, readBuffer, *checksum, wantedAvailableRange,
@@ -560,9 +828,21 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         }
 
         const auto bytesRead = readBuffer.chainLength();
-        if (!m_readEventsDisabled) {
-            m_eventManager.emit<events::FileRead>(
-                uuid.toStdString(), offset, bytesRead);
+        if (!m_readEventsDisabled && bytesRead > 0) {
+            // Contiguous reads are coalesced in the handle and emitted as
+            // a single event
+            auto previousRead = fuseFileHandle->addPendingRead(uuid,
+                boost::icl::discrete_interval<off_t>::right_open(
+                    offset, offset + bytesRead));
+
+            if (previousRead)
+                publishRead(std::move(*previousRead));
+
+            if (fuseFileHandle->pendingReadSize() >=
+                FSLOGIC_READ_EXTENT_BATCH_SIZE)
+                publishPendingRead(fuseFileHandle);
+            else
+                schedulePendingExtentsPublish();
         }
 
         LOG_DBG(2) << "Read " << bytesRead << " bytes from " << uuid
@@ -606,7 +886,7 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         }
 
         if ((e.code().value() == EAGAIN) && (retriesLeft > 0)) {
-            fiberRetryDelay(retriesLeft);
+            fiberRetryDelay(retriesLeft, storageId);
             return read(uuid, fileHandleId, offset, size, checksum,
                 retriesLeft - 1, std::move(ioTraceEntry));
         }
@@ -827,6 +1107,110 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
         return 0;
     }
 
+    // Handles opened for synchronous or direct I/O bypass the journal
+    if (m_writeBackDirectory &&
+        (m_fuseFileHandles.at(fuseFileHandleId)->flags() &
+            WRITE_THROUGH_FLAGS) == 0)
+        return writeBack(uuid, fuseFileHandleId, offset, std::move(buf));
+
+    uploadOtherWriteBackJournals(uuid, fuseFileHandleId);
+
+    return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf),
+        retriesLeft, std::move(ioTraceEntry));
+}
+
+std::size_t FsLogic::writeBack(const folly::fbstring &uuid,
+    const std::uint64_t fuseFileHandleId, const off_t offset,
+    std::shared_ptr<folly::IOBuf> buf)
+{
+    auto fuseFileHandle = m_fuseFileHandles.at(fuseFileHandleId);
+
+    if (isSpaceDisabled(m_metadataCache.getSpaceId(uuid))) {
+        LOG(ERROR) << "Write to file " << uuid << " failed - space "
+                   << m_metadataCache.getSpaceId(uuid) << " quota exceeded";
+        throw std::errc::no_space_on_device; // NOLINT
+    }
+
+    if (fuseFileHandle->writeBackJournal() == nullptr)
+        fuseFileHandle->setWriteBackJournal(std::make_unique<WriteBackJournal>(
+            *m_writeBackDirectory, fuseFileHandleId));
+
+    auto journal = fuseFileHandle->writeBackJournal();
+
+    // Report the failure of a background upload on the next write
+    journal->rethrowError();
+
+    const auto size = buf->computeChainDataLength();
+
+    if (journal->dirtySize() + size > m_writeBackFileDirtyLimit ||
+        m_writeBackDirtySize + size > m_writeBackDirtyLimit) {
+        LOG_DBG(2) << "Write-back dirty limit reached for file " << uuid
+                   << " - uploading journal";
+
+        uploadWriteBackJournal(fuseFileHandle);
+
+        if (size > m_writeBackFileDirtyLimit ||
+            m_writeBackDirtySize + size > m_writeBackDirtyLimit) {
+            uploadOtherWriteBackJournals(uuid, fuseFileHandleId);
+            return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf));
+        }
+    }
+
+    uploadOtherWriteBackJournals(uuid, fuseFileHandleId);
+
+    try {
+        journal->append(uuid, offset, *buf);
+    }
+    catch (const std::system_error &e) {
+        LOG(WARNING) << "Appending to write-back journal of file " << uuid
+                     << " failed: " << e.what() << " - writing through";
+
+        uploadWriteBackJournal(fuseFileHandle);
+        uploadOtherWriteBackJournals(uuid, fuseFileHandleId);
+        return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf));
+    }
+
+    m_writeBackDirtySize += size;
+    ONE_METRIC_COUNTER_SET(
+        "comp.oneclient.mod.fslogic.writeback.dirty", m_writeBackDirtySize);
+
+    m_writeBackHandleIds[uuid] = fuseFileHandleId;
+
+    m_metadataCache.extendSize(uuid, offset + size);
+
+    if (journal->scheduleUpload()) {
+        m_runInFiber([this, fuseFileHandleId] {
+            auto it = m_fuseFileHandles.find(fuseFileHandleId);
+            if (it == m_fuseFileHandles.end())
+                return;
+
+            auto fuseFileHandle = it->second;
+            fuseFileHandle->writeBackJournal()->startUpload();
+
+            try {
+                uploadWriteBackJournal(fuseFileHandle);
+            }
+            catch (const std::exception &e) {
+                LOG(WARNING) << "Background upload of write-back journal "
+                                "for file handle "
+                             << fuseFileHandleId << " failed: " << e.what();
+                fuseFileHandle->writeBackJournal()->setError(
+                    std::current_exception());
+            }
+        });
+    }
+
+    return size;
+}
+
+std::size_t FsLogic::writeThrough(const folly::fbstring &uuid,
+    const std::uint64_t fuseFileHandleId, const off_t offset,
+    std::shared_ptr<folly::IOBuf> buf, const int retriesLeft,
+    std::unique_ptr<IOTraceWrite> ioTraceEntry)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(fuseFileHandleId)
+                << LOG_FARG(offset) << LOG_FARG(buf->length());
+
     if (m_ioTraceLoggerEnabled && !ioTraceEntry) {
         ioTraceEntry = std::make_unique<IOTraceWrite>();
         ioTraceEntry->opType = IOTraceLogger::OpType::WRITE;
@@ -852,15 +1236,17 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
 
     size_t bytesWritten = 0;
     try {
-        auto helperHandle = fuseFileHandle->getHelperHandle(
-            uuid, spaceId, fileBlock.storageId(), fileBlock.fileId());
+        helpers::FileHandlePtr helperHandle;
+        folly::Optional<IOPath> ioPath;
+        std::tie(helperHandle, ioPath) =
+            getStorageHelperHandle(fuseFileHandle, uuid, spaceId, fileBlock);
 
         folly::IOBufQueue bufq{folly::IOBufQueue::cacheChainLength()};
         bufq.append(buf->clone());
 
         bytesWritten =
-            communication::wait(helperHandle->write(offset, std::move(bufq)),
-                helperHandle->timeout());
+            waitForStorage(fileBlock.storageId(), ioPath, helperHandle,
+                helperHandle->write(offset, std::move(bufq)));
     }
     catch (const std::system_error &e) {
         if ((e.code().value() == EKEYEXPIRED) && (retriesLeft > 0)) {
@@ -885,13 +1271,13 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
                     });
                 });
 
-            return write(uuid, fuseFileHandleId, offset, std::move(buf),
+            return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf),
                 retriesLeft - 1, std::move(ioTraceEntry));
         }
 
         if ((e.code().value() == EAGAIN) && (retriesLeft > 0)) {
-            fiberRetryDelay(retriesLeft);
-            return write(uuid, fuseFileHandleId, offset, std::move(buf),
+            fiberRetryDelay(retriesLeft, fileBlock.storageId());
+            return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf),
                 retriesLeft - 1, std::move(ioTraceEntry));
         }
 
@@ -915,13 +1301,10 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
         LOG_DBG(1) << "Writing requested block for " << uuid
                    << " via proxy fallback";
 
-        return write(uuid, fuseFileHandleId, offset, std::move(buf),
+        return writeThrough(uuid, fuseFileHandleId, offset, std::move(buf),
             retriesLeft, std::move(ioTraceEntry));
     }
 
-    m_eventManager.emit<events::FileWritten>(uuid.toStdString(), offset,
-        bytesWritten, fileBlock.storageId(), fileBlock.fileId());
-
     auto writtenRange = boost::icl::discrete_interval<off_t>::right_open(
         offset, offset + bytesWritten);
 
@@ -929,7 +1312,21 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
                << " at offset " << offset << " on storage "
                << fileBlock.storageId();
 
-    m_metadataCache.addBlock(uuid, writtenRange, std::move(fileBlock));
+    // Contiguous writes are coalesced in the handle and published to the
+    // file location and events stream in batches
+    auto previousWrite = fuseFileHandle->addPendingWrite(
+        uuid, writtenRange, std::move(fileBlock));
+
+    if (previousWrite)
+        publishWrite(std::move(*previousWrite));
+
+    if (fuseFileHandle->pendingWriteSize() >= m_writeExtentBatchSize) {
+        publishPendingWrite(fuseFileHandle);
+    }
+    else {
+        m_metadataCache.extendSize(uuid, writtenRange.upper());
+        schedulePendingExtentsPublish();
+    }
 
     if (m_tagOnModify && !fuseFileHandle->isOnModifyTagSet()) {
         std::string tagNameJsonEncoded;
@@ -943,8 +1340,7 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
                        << uuid;
         }
         else {
-            FsLogic::setxattr(
-                uuid, tagNameJsonEncoded, tagValueJsonEncoded, false, false);
+            tagFile(uuid, tagNameJsonEncoded, tagValueJsonEncoded);
         }
         fuseFileHandle->setOnModifyTag();
     }
@@ -977,6 +1373,8 @@ FileAttrPtr FsLogic::mkdir(const folly::fbstring &parentUuid,
     // TODO: Provider returns uuid of the created dir, no need for lookup
     auto attr = m_metadataCache.getAttr(parentUuid, name);
 
+    m_readdirCache->addEntry(parentUuid, name);
+
     IOTRACE_END(IOTraceMkdir, IOTraceLogger::OpType::MKDIR, parentUuid, 0, name,
         attr->uuid(), mode)
 
@@ -1008,7 +1406,7 @@ FileAttrPtr FsLogic::mknod(const folly::fbstring &parentUuid,
     auto sharedAttr = std::make_shared<FileAttr>(std::move(attr));
     m_metadataCache.putAttr(sharedAttr);
 
-    m_readdirCache->invalidate(parentUuid);
+    m_readdirCache->addEntry(parentUuid, name);
 
     IOTRACE_END(IOTraceMknod, IOTraceLogger::OpType::MKNOD, parentUuid, 0, name,
         sharedAttr->uuid(), mode)
@@ -1052,13 +1450,14 @@ std::pair<FileAttrPtr, std::uint64_t> FsLogic::create(
     auto fuseFileHandle = std::make_shared<FuseFileHandle>(flags,
         created.handleId(), openFileToken, *m_helpersCache, m_forceProxyIOCache,
         m_providerTimeout);
+    fuseFileHandle->setHelperHandlePool(&m_helperHandlePool);
 
     m_fuseFileHandles.emplace(fuseFileHandleId, fuseFileHandle);
 
     LOG_DBG(2) << "Created file " << name << " in " << parentUuid
                << " with uuid " << uuid;
 
-    m_readdirCache->invalidate(parentUuid);
+    m_readdirCache->addEntry(parentUuid, name);
 
     if (m_tagOnCreate && !fuseFileHandle->isOnCreateTagSet()) {
         std::string tagNameJsonEncoded;
@@ -1072,8 +1471,7 @@ std::pair<FileAttrPtr, std::uint64_t> FsLogic::create(
                        << uuid;
         }
         else {
-            FsLogic::setxattr(uuid, m_tagOnCreate.get().first,
-                tagValueJsonEncoded, false, false);
+            tagFile(uuid, m_tagOnCreate.get().first, tagValueJsonEncoded);
         }
         fuseFileHandle->setOnCreateTag();
     }
@@ -1098,8 +1496,6 @@ void FsLogic::unlink(
 
     m_metadataCache.markDeleted(attr->uuid());
 
-    m_readdirCache->invalidate(parentUuid);
-
     IOTRACE_END(IOTraceUnlink, IOTraceLogger::OpType::UNLINK, parentUuid, 0,
         name, attr->uuid())
 
@@ -1120,6 +1516,8 @@ void FsLogic::rename(const folly::fbstring &parentUuid,
     auto attr = m_metadataCache.getAttr(parentUuid, name);
     auto oldUuid = attr->uuid();
 
+    publishPendingWrites(oldUuid);
+
     auto renamed = communicate<messages::fuse::FileRenamed>(
         messages::fuse::Rename{oldUuid.toStdString(),
             newParentUuid.toStdString(), newName.toStdString()},
@@ -1141,6 +1539,8 @@ void FsLogic::rename(const folly::fbstring &parentUuid,
 std::map<folly::fbstring, folly::fbvector<std::pair<off_t, off_t>>>
 FsLogic::getFileLocalBlocks(const folly::fbstring &uuid)
 {
+    publishPendingWrites(uuid);
+
     return m_metadataCache.getLocation(uuid)->getFileLocalBlocks();
 }
 
@@ -1175,6 +1575,8 @@ FileAttrPtr FsLogic::setattr(
     }
 
     if ((toSet & FUSE_SET_ATTR_SIZE) != 0) {
+        publishPendingWrites(uuid);
+
         communicate(messages::fuse::Truncate{uuid.toStdString(), attr.st_size},
             m_providerTimeout);
         m_metadataCache.truncate(uuid, attr.st_size);
@@ -1252,11 +1654,14 @@ folly::fbstring FsLogic::getxattr(
     }
 
     if (name == ONE_XATTR("access_type")) {
-        auto accessType = m_helpersCache->getAccessType(
-            m_metadataCache.getDefaultBlock(uuid).storageId());
+        const auto storageId =
+            m_metadataCache.getDefaultBlock(uuid).storageId();
+        auto accessType = m_helpersCache->getAccessType(storageId);
 
         if (accessType == cache::HelpersCache::AccessType::DIRECT)
-            return "\"direct\"";
+            return m_ioPathSelector.preferredPath(storageId) == IOPath::DIRECT
+                ? "\"direct\""
+                : "\"proxy\"";
 
         if (accessType == cache::HelpersCache::AccessType::PROXY)
             return "\"proxy\"";
@@ -1265,6 +1670,7 @@ folly::fbstring FsLogic::getxattr(
     }
 
     if (name == ONE_XATTR("file_blocks_count")) {
+        publishPendingWrites(uuid);
         auto forceLocationUpdate =
             !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid);
         return "\"" +
@@ -1275,6 +1681,7 @@ folly::fbstring FsLogic::getxattr(
     }
 
     if (name == ONE_XATTR("file_blocks")) {
+        publishPendingWrites(uuid);
         std::size_t size = m_metadataCache.getAttr(uuid)->size().value_or(0);
         if (size == 0) {
             return "\"empty\"";
@@ -1289,6 +1696,7 @@ folly::fbstring FsLogic::getxattr(
     }
 
     if (name == ONE_XATTR("replication_progress")) {
+        publishPendingWrites(uuid);
         std::size_t size = m_metadataCache.getAttr(uuid)->size().value_or(0);
 
         auto forceLocationUpdate =
@@ -1391,6 +1799,15 @@ folly::fbvector<folly::fbstring> FsLogic::listxattr(const folly::fbstring &uuid)
 template <typename SrvMsg, typename CliMsg>
 SrvMsg FsLogic::communicate(CliMsg &&msg, const std::chrono::seconds timeout)
 {
+    return communicateAsync<SrvMsg>(std::forward<CliMsg>(msg), timeout).get();
+}
+
+template <typename SrvMsg, typename CliMsg>
+folly::Future<SrvMsg> FsLogic::communicateAsync(
+    CliMsg &&msg, const std::chrono::seconds timeout)
+{
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fslogic.requests");
+
     auto messageString = msg.toString();
     return m_context->communicator()
         ->communicate<SrvMsg>(std::forward<CliMsg>(msg))
@@ -1403,8 +1820,7 @@ SrvMsg FsLogic::communicate(CliMsg &&msg, const std::chrono::seconds timeout)
                            << " not received within " << timeout << " seconds.";
                 return folly::makeFuture<SrvMsg>(std::system_error{
                     std::make_error_code(std::errc::timed_out)});
-            })
-        .get();
+            });
 }
 
 folly::fbstring FsLogic::syncAndFetchChecksum(const folly::fbstring &uuid,
@@ -1492,15 +1908,525 @@ void FsLogic::disableSpaces(const std::vector<std::string> &spaces)
     m_disabledSpaces = {spaces.begin(), spaces.end()};
 }
 
-void FsLogic::fiberRetryDelay(int retriesLeft)
+void FsLogic::tagFile(const folly::fbstring &uuid,
+    const folly::fbstring &name, const folly::fbstring &value)
+{
+    LOG_DBG(2) << "Setting tag " << name << " on file " << uuid;
+
+    IOTRACE_GUARD(IOTraceSetXAttr, IOTraceLogger::OpType::SETXATTR, uuid, 0,
+        name, value, false, false)
+
+    communicateAsync(
+        messages::fuse::SetXAttr{uuid, name, value, false, false},
+        m_providerTimeout)
+        .then([uuid, name](folly::Try<messages::fuse::FuseResponse> &&t) {
+            if (t.hasException())
+                LOG(WARNING) << "Setting tag " << name << " on file " << uuid
+                             << " failed: " << t.exception().what();
+        });
+}
+
+void FsLogic::publishWrite(FuseFileHandle::PendingWrite pendingWrite)
+{
+    const auto &range = pendingWrite.range;
+
+    LOG_DBG(2) << "Publishing written range " << range << " of file "
+               << pendingWrite.uuid << " on storage "
+               << pendingWrite.fileBlock.storageId();
+
+    m_eventManager.emit<events::FileWritten>(pendingWrite.uuid.toStdString(),
+        range.lower(), boost::icl::size(range),
+        pendingWrite.fileBlock.storageId(), pendingWrite.fileBlock.fileId());
+
+    m_metadataCache.addBlock(
+        pendingWrite.uuid, range, std::move(pendingWrite.fileBlock));
+}
+
+void FsLogic::publishPendingWrite(
+    const std::shared_ptr<FuseFileHandle> &fuseFileHandle)
+{
+    auto pendingWrite = fuseFileHandle->takePendingWrite();
+    if (pendingWrite)
+        publishWrite(std::move(*pendingWrite));
+}
+
+void FsLogic::publishPendingRead(
+    const std::shared_ptr<FuseFileHandle> &fuseFileHandle)
+{
+    auto pendingRead = fuseFileHandle->takePendingRead();
+    if (pendingRead)
+        publishRead(std::move(*pendingRead));
+}
+
+void FsLogic::publishRead(FuseFileHandle::PendingRead pendingRead)
+{
+    const auto &range = pendingRead.range;
+
+    LOG_DBG(2) << "Publishing read range " << range << " of file "
+               << pendingRead.uuid << " coalesced from " << pendingRead.counter
+               << " reads of " << pendingRead.size << " bytes";
+
+    m_eventManager.emit<events::FileRead>(pendingRead.uuid.toStdString(),
+        range, pendingRead.size, pendingRead.counter);
+}
+
+void FsLogic::uploadWriteBackJournal(
+    const std::shared_ptr<FuseFileHandle> &fuseFileHandle)
+{
+    auto journal = fuseFileHandle->writeBackJournal();
+    if (journal == nullptr)
+        return;
+
+    std::lock_guard<folly::fibers::TimedMutex> guard{journal->uploadMutex()};
+
+    while (!journal->empty()) {
+        const auto entry = journal->front();
+        auto buf = journal->read(entry);
+        auto offset = entry.offset;
+
+        while (!buf->empty()) {
+            const auto written = writeThrough(
+                journal->uuid(), journal->fuseFileHandleId(), offset, buf);
+            if (written == 0)
+                throw std::errc::io_error; // NOLINT
+
+            buf->trimStart(written);
+            offset += written;
+        }
+
+        journal->popFront();
+        m_writeBackDirtySize -= entry.size;
+        ONE_METRIC_COUNTER_SET(
+            "comp.oneclient.mod.fslogic.writeback.dirty", m_writeBackDirtySize);
+    }
+
+    auto owner = m_writeBackHandleIds.find(journal->uuid());
+    if (owner != m_writeBackHandleIds.end() &&
+        owner->second == journal->fuseFileHandleId())
+        m_writeBackHandleIds.erase(owner);
+
+    // The entries of a failed background upload have been retried above, so
+    // its error is only reported now
+    journal->rethrowError();
+}
+
+void FsLogic::uploadWriteBackJournals(const folly::fbstring &uuid)
+{
+    auto owner = m_writeBackHandleIds.find(uuid);
+    if (owner == m_writeBackHandleIds.end())
+        return;
+
+    auto it = m_fuseFileHandles.find(owner->second);
+    if (it == m_fuseFileHandles.end()) {
+        m_writeBackHandleIds.erase(owner);
+        return;
+    }
+
+    uploadWriteBackJournal(it->second);
+}
+
+void FsLogic::uploadOtherWriteBackJournals(
+    const folly::fbstring &uuid, const std::uint64_t fuseFileHandleId)
+{
+    // Another handle can start journaling the file while the fiber is
+    // suspended in the upload, so the owner is checked again afterwards
+    for (auto owner = m_writeBackHandleIds.find(uuid);
+         owner != m_writeBackHandleIds.end() &&
+         owner->second != fuseFileHandleId;
+         owner = m_writeBackHandleIds.find(uuid))
+        uploadWriteBackJournals(uuid);
+}
+
+bool FsLogic::publishPendingWrites(const folly::fbstring &uuid)
+{
+    uploadWriteBackJournals(uuid);
+
+    bool published = false;
+    for (auto &fuseFileHandle : m_fuseFileHandles) {
+        if (fuseFileHandle.second->hasPendingWrite(uuid)) {
+            publishPendingWrite(fuseFileHandle.second);
+            published = true;
+        }
+    }
+
+    return published;
+}
+
+void FsLogic::schedulePendingExtentsPublish()
+{
+    if (m_pendingExtentsPublishScheduled)
+        return;
+
+    m_pendingExtentsPublishScheduled = true;
+    m_context->timingWheel()->schedule(FSLOGIC_PENDING_EXTENT_MAX_AGE,
+        [ this, runInFiber = guardedRunInFiber() ]() mutable {
+            runInFiber([this] { publishExpiredPendingExtents(); });
+        });
+}
+
+void FsLogic::publishExpiredPendingExtents()
+{
+    m_pendingExtentsPublishScheduled = false;
+
+    const auto now = std::chrono::steady_clock::now();
+    bool remaining = false;
+
+    for (auto &fuseFileHandle : m_fuseFileHandles) {
+        auto writeSince = fuseFileHandle.second->pendingWriteSince();
+        if (writeSince) {
+            if (now - *writeSince >= FSLOGIC_PENDING_EXTENT_MAX_AGE)
+                publishPendingWrite(fuseFileHandle.second);
+            else
+                remaining = true;
+        }
+
+        auto readSince = fuseFileHandle.second->pendingReadSince();
+        if (readSince) {
+            if (now - *readSince >= FSLOGIC_PENDING_EXTENT_MAX_AGE)
+                publishPendingRead(fuseFileHandle.second);
+            else
+                remaining = true;
+        }
+    }
+
+    if (remaining)
+        schedulePendingExtentsPublish();
+}
+
+std::pair<helpers::FileHandlePtr, folly::Optional<IOPath>>
+FsLogic::getStorageHelperHandle(
+    const std::shared_ptr<FuseFileHandle> &fuseFileHandle,
+    const folly::fbstring &uuid, const folly::fbstring &spaceId,
+    const messages::fuse::FileBlock &fileBlock)
+{
+    const auto &storageId = fileBlock.storageId();
+
+    auto isDirectIO = [&] {
+        return !m_forceProxyIOCache.contains(uuid) &&
+            m_helpersCache->getAccessType(storageId) ==
+            cache::HelpersCache::AccessType::DIRECT;
+    };
+
+    if (isDirectIO()) {
+        // The path is pinned on the first access of the file handle to the
+        // storage, so that data written through one helper handle is not
+        // read through the other one
+        auto path = fuseFileHandle->ioPath(storageId);
+        const bool pinned = path.hasValue();
+        if (!pinned)
+            path = m_ioPathSelector.choose(storageId);
+
+        // Only direct requests probe the storage and report its health
+        if (*path == IOPath::DIRECT &&
+            !m_storageHealth.allowRequest(storageId)) {
+            if (pinned || m_context->options()->isDirectIOForced()) {
+                LOG_DBG(1) << "Failing request to storage " << storageId
+                           << " due to open circuit breaker";
+                throw std::errc::io_error; // NOLINT
+            }
+
+            LOG_DBG(1) << "Routing requests to storage " << storageId
+                       << " through proxy IO due to open circuit breaker";
+
+            ONE_METRIC_COUNTER_INC(
+                "comp.oneclient.mod.fslogic.storages.breaker.rerouted");
+
+            path = IOPath::PROXY;
+        }
+
+        if (!pinned)
+            fuseFileHandle->setIOPath(storageId, *path);
+
+        return {fuseFileHandle->getHelperHandle(uuid, spaceId, storageId,
+                    fileBlock.fileId(), *path == IOPath::PROXY),
+            *path};
+    }
+
+    auto helperHandle = fuseFileHandle->getHelperHandle(
+        uuid, spaceId, storageId, fileBlock.fileId());
+
+    // Access type of the storage is known once its helper has been created
+    if (!isDirectIO())
+        return {std::move(helperHandle), {}};
+
+    fuseFileHandle->setIOPath(storageId, IOPath::DIRECT);
+    return {std::move(helperHandle), IOPath::DIRECT};
+}
+
+template <typename T>
+T FsLogic::waitForStorage(const folly::fbstring &storageId,
+    const folly::Optional<IOPath> path,
+    const helpers::FileHandlePtr &helperHandle, folly::Future<T> future)
+{
+    if (!path)
+        return communication::wait(future, helperHandle->timeout());
+
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&] {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    };
+
+    auto recordFailure = [&] {
+        if (*path == IOPath::DIRECT)
+            m_storageHealth.recordFailure(storageId);
+        m_ioPathSelector.recordSample(storageId, *path, 0, elapsed());
+    };
+
+    try {
+        auto result = communication::wait(future, helperHandle->timeout());
+
+        const auto duration = elapsed();
+        if (*path == IOPath::DIRECT)
+            m_storageHealth.recordSuccess(storageId, duration);
+        m_ioPathSelector.recordSample(
+            storageId, *path, transferredBytes(result), duration);
+
+        return result;
+    }
+    catch (const std::system_error &e) {
+        if (isStorageFailure(e.code()))
+            recordFailure();
+        throw;
+    }
+    catch (const communication::TimeoutExceeded &) {
+        recordFailure();
+        throw;
+    }
+}
+
+void FsLogic::scheduleHelperHandlePoolPrune()
 {
-    const auto retryIndex =
-        std::min(std::max(0, FSLOGIC_RETRY_COUNT - retriesLeft),
-            FSLOGIC_RETRY_COUNT - 1);
+    if (m_helperHandlePoolPruneScheduled)
+        return;
+
+    m_helperHandlePoolPruneScheduled = true;
+    m_context->timingWheel()->schedule(FSLOGIC_HELPER_HANDLE_POOL_GRACE_PERIOD,
+        [ this, runInFiber = guardedRunInFiber() ]() mutable {
+            runInFiber([this] { pruneHelperHandlePool(); });
+        });
+}
+
+void FsLogic::pruneHelperHandlePool()
+{
+    m_helperHandlePoolPruneScheduled = false;
+
+    m_helperHandlePool.prune();
+
+    if (m_helperHandlePool.size() > 0)
+        scheduleHelperHandlePoolPrune();
+}
+
+void FsLogic::detectStorages()
+{
+    LOG_FCALL();
+
+    const auto deadline =
+        std::chrono::steady_clock::now() + FSLOGIC_STORAGE_DETECTION_DEADLINE;
+
+    std::vector<folly::Future<cache::HelpersCache::HelperPtr>> detections;
+    folly::fbvector<folly::fbstring> spaceNames;
+
+    try {
+        spaceNames = m_readdirCache->readdir(
+            m_rootUuid, 0, std::numeric_limits<std::size_t>::max());
+    }
+    catch (const std::exception &e) {
+        LOG(WARNING) << "Cannot list spaces for storage detection: "
+                     << e.what();
+        return;
+    }
+
+    for (const auto &spaceName : spaceNames) {
+        if (spaceName == "." || spaceName == "..")
+            continue;
+
+        if (std::chrono::steady_clock::now() > deadline) {
+            LOG(WARNING) << "Storage detection deadline exceeded - remaining "
+                            "storages will be detected on first access";
+            break;
+        }
+
+        try {
+            auto attr = m_metadataCache.getAttr(m_rootUuid, spaceName);
+            const auto &uuid = attr->uuid();
+            auto spaceId = m_metadataCache.getSpaceId(uuid);
+            if (isSpaceDisabled(spaceId))
+                continue;
+
+            auto storageId = m_metadataCache.getDefaultBlock(uuid).storageId();
+
+            LOG_DBG(1) << "Detecting access to storage " << storageId
+                       << " of space " << spaceName;
+
+            detections.emplace_back(
+                m_helpersCache->get(uuid, spaceId, storageId, false));
+        }
+        catch (const std::exception &e) {
+            LOG(WARNING) << "Cannot start storage detection for space "
+                         << spaceName << ": " << e.what();
+        }
+    }
+
+    LOG(INFO) << "Started storage detection for " << detections.size()
+              << " spaces";
+
+    folly::collectAll(detections).then(
+        [](const std::vector<folly::Try<cache::HelpersCache::HelperPtr>>
+                &helpers) {
+            LOG_DBG(1) << "Initial storage detection for " << helpers.size()
+                       << " spaces completed";
+        });
+}
+
+void FsLogic::warmupMetadata(const boost::filesystem::path &manifestPath)
+{
+    LOG_FCALL() << LOG_FARG(manifestPath.string());
+
+    std::ifstream manifest{manifestPath.string()};
+    if (!manifest) {
+        LOG(WARNING) << "Cannot open metadata warmup manifest "
+                     << manifestPath.string();
+        return;
+    }
+
+    auto state = std::make_shared<MetadataWarmupState>();
+    state->start = std::chrono::steady_clock::now();
+
+    for (auto &path : parseMetadataWarmupManifest(manifest)) {
+        auto sharedPath =
+            std::make_shared<const MetadataWarmupPath>(std::move(path));
+        state->queue.emplace_back(
+            MetadataWarmupItem{m_rootUuid, sharedPath->front(), sharedPath, 0});
+    }
+
+    LOG(INFO) << "Starting metadata warmup of " << state->queue.size()
+              << " paths from " << manifestPath.string();
+
+    spawnMetadataWarmupWorkers(std::move(state));
+}
+
+void FsLogic::spawnMetadataWarmupWorkers(
+    std::shared_ptr<MetadataWarmupState> state)
+{
+    while (state->workers < FSLOGIC_METADATA_WARMUP_CONCURRENCY &&
+        state->workers < state->queue.size()) {
+        ++state->workers;
+        guardedRunInFiber()([this, state] {
+            while (!state->queue.empty()) {
+                auto item = std::move(state->queue.front());
+                state->queue.pop_front();
+                warmupMetadataItem(*state, item);
+                spawnMetadataWarmupWorkers(state);
+            }
+
+            if (--state->workers > 0)
+                return;
+
+            const auto duration =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - state->start);
+
+            LOG(INFO) << "Metadata warmup resolved " << state->resolved
+                      << " paths in " << duration.count() << "ms, "
+                      << state->failed << " failed";
+
+            if (state->truncated)
+                LOG(WARNING) << "Metadata warmup stopped after resolving "
+                                "as many paths as fit in the metadata cache";
 
-    auto delayRange = FSLOGIC_RETRY_DELAYS.at(retryIndex);
-    auto delay = std::chrono::milliseconds(delayRange.first +
-        (std::rand() % (delayRange.second - delayRange.first + 1))); // NOLINT
+            ONE_METRIC_COUNTER_SET(
+                "comp.oneclient.mod.fslogic.warmup.resolved", state->resolved);
+            ONE_METRIC_COUNTER_SET(
+                "comp.oneclient.mod.fslogic.warmup.failed", state->failed);
+            ONE_METRIC_COUNTER_SET("comp.oneclient.mod.fslogic.warmup.duration",
+                duration.count());
+        });
+    }
+}
+
+void FsLogic::warmupMetadataItem(
+    MetadataWarmupState &state, const MetadataWarmupItem &item)
+{
+    const auto &path = *item.path;
+
+    try {
+        if (isMetadataWarmupPattern(item.name)) {
+            auto entries = m_readdirCache->readdir(
+                item.parentUuid, 0, std::numeric_limits<std::size_t>::max());
+
+            for (auto &entry : entries) {
+                if (entry == "." || entry == ".." ||
+                    !matchesMetadataWarmupPattern(item.name, entry))
+                    continue;
+
+                state.queue.emplace_back(MetadataWarmupItem{
+                    item.parentUuid, std::move(entry), item.path, item.depth});
+            }
+            return;
+        }
+
+        // Further lookups would only evict the already warmed up entries
+        if (state.resolved >= m_context->options()->getMetadataCacheSize()) {
+            state.truncated = true;
+            return;
+        }
+
+        auto attr = lookup(item.parentUuid, item.name);
+        ++state.resolved;
+
+        if (item.depth + 1 < path.size()) {
+            if (attr->type() == FileAttr::FileType::directory)
+                state.queue.emplace_back(MetadataWarmupItem{attr->uuid(),
+                    path[item.depth + 1], item.path, item.depth + 1});
+            return;
+        }
+
+        if (attr->type() == FileAttr::FileType::regular &&
+            m_context->options()->isMetadataWarmupLocationsEnabled())
+            m_metadataCache.getLocation(attr->uuid());
+    }
+    catch (const std::exception &e) {
+        ++state.failed;
+        LOG_DBG(1) << "Metadata warmup of '" << item.name << "' in "
+                   << item.parentUuid << " failed: " << e.what();
+    }
+}
+
+std::function<void(folly::Function<void()>)> FsLogic::guardedRunInFiber()
+{
+    return [ this, liveness = m_liveness ](folly::Function<void()> fun)
+    {
+        std::lock_guard<std::mutex> guard{liveness->mutex};
+        if (liveness->alive)
+            m_runInFiber(std::move(fun));
+    };
+}
+
+void FsLogic::fiberRetryDelay(
+    int retriesLeft, const folly::fbstring &storageId)
+{
+    std::chrono::milliseconds delay;
+
+    // Retries of operations on a failing storage share the backoff, so that
+    // they don't all hit a degraded storage with short delays
+    folly::Optional<std::chrono::milliseconds> storageDelay;
+    if (!storageId.empty())
+        storageDelay = m_storageHealth.retryDelay(storageId);
+
+    if (storageDelay) {
+        delay = *storageDelay;
+    }
+    else {
+        const auto retryIndex =
+            std::min(std::max(0, FSLOGIC_RETRY_COUNT - retriesLeft),
+                FSLOGIC_RETRY_COUNT - 1);
+
+        auto delayRange = FSLOGIC_RETRY_DELAYS.at(retryIndex);
+        delay = std::chrono::milliseconds(delayRange.first +
+            (std::rand() % // NOLINT
+                (delayRange.second - delayRange.first + 1)));
+    }
 
     LOG_DBG(1) << "Retrying FsLogic operation due to resource "
                   "temporarily unavailable error in "
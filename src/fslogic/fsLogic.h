@@ -12,12 +12,16 @@
 
 #include "attrs.h"
 #include "cache/forceProxyIOCache.h"
+#include "cache/helperHandlePool.h"
 #include "cache/helpersCache.h"
 #include "cache/lruMetadataCache.h"
 #include "cache/readdirCache.h"
 #include "events/events.h"
 #include "fsSubscriptions.h"
 #include "ioTraceLogger.h"
+#include "ioPathSelector.h"
+#include "metadataWarmup.h"
+#include "storageHealthTracker.h"
 
 #include <asio/buffer.hpp>
 #include <boost/icl/discrete_interval.hpp>
@@ -26,8 +30,10 @@
 #include <folly/Function.h>
 #include <folly/io/IOBufQueue.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
@@ -59,6 +65,29 @@ constexpr auto SYNCHRONIZE_BLOCK_PRIORITY_IMMEDIATE = 32;
 constexpr auto SYNCHRONIZE_BLOCK_PRIORITY_LINEAR_PREFETCH = 96;
 constexpr auto SYNCHRONIZE_BLOCK_PRIORITY_CLUSTER_PREFETCH = 160;
 
+// Maximum size of contiguous reads through a single file handle represented
+// by a single read event
+constexpr auto FSLOGIC_READ_EXTENT_BATCH_SIZE = 16 * 1024 * 1024;
+
+// Maximum time for which a coalesced extent can be held in a file handle
+// before it is published, regardless of its size
+constexpr std::chrono::milliseconds FSLOGIC_PENDING_EXTENT_MAX_AGE{500};
+
+// Time for which helper handles of released files are kept in the helper
+// handle pool for reuse
+constexpr std::chrono::seconds FSLOGIC_HELPER_HANDLE_POOL_GRACE_PERIOD{5};
+
+/**
+ * Maximum time spent on enumerating storages for detection after mount.
+ */
+constexpr std::chrono::seconds FSLOGIC_STORAGE_DETECTION_DEADLINE{30};
+
+/**
+ * Maximum number of path components resolved concurrently during metadata
+ * warmup.
+ */
+constexpr std::size_t FSLOGIC_METADATA_WARMUP_CONCURRENCY = 16;
+
 /**
  * The FsLogic main class.
  * This class contains FUSE all callbacks, so it basically is an heart of the
@@ -260,6 +289,20 @@ private:
     template <typename SrvMsg = messages::fuse::FuseResponse, typename CliMsg>
     SrvMsg communicate(CliMsg &&msg, const std::chrono::seconds timeout);
 
+    template <typename SrvMsg = messages::fuse::FuseResponse, typename CliMsg>
+    folly::Future<SrvMsg> communicateAsync(
+        CliMsg &&msg, const std::chrono::seconds timeout);
+
+    /**
+     * Performs provider fsync, releases helper handles and finally sends
+     * the release message for an open file.
+     * @param uuid Uuid of the file.
+     * @param fuseFileHandle The file handle to release.
+     * @returns Future fulfilled when the file has been released.
+     */
+    folly::Future<folly::Unit> releaseFileHandle(const folly::fbstring &uuid,
+        const std::shared_ptr<FuseFileHandle> &fuseFileHandle);
+
     folly::fbstring syncAndFetchChecksum(const folly::fbstring &uuid,
         const boost::icl::discrete_interval<off_t> &range);
 
@@ -289,18 +332,208 @@ private:
         const boost::icl::discrete_interval<off_t> possibleRange,
         const boost::icl::discrete_interval<off_t> availableRange);
 
+    /**
+     * Sets an extended attribute tag on a file without waiting for the
+     * provider response. Failures are only logged.
+     * @param uuid Uuid of the file.
+     * @param name Name of the extended attribute.
+     * @param value JSON encoded value of the extended attribute.
+     */
+    void tagFile(const folly::fbstring &uuid, const folly::fbstring &name,
+        const folly::fbstring &value);
+
+    /**
+     * Adds a written range to the file location in metadata cache and emits
+     * the corresponding @c FileWritten event.
+     * @param pendingWrite Written range along with its file block.
+     */
+    void publishWrite(FuseFileHandle::PendingWrite pendingWrite);
+
+    /**
+     * Publishes the write extent accumulated in a file handle, if any.
+     * @param fuseFileHandle The file handle.
+     */
+    void publishPendingWrite(
+        const std::shared_ptr<FuseFileHandle> &fuseFileHandle);
+
+    /**
+     * Writes data directly to the storage.
+     * @see write
+     */
+    std::size_t writeThrough(const folly::fbstring &uuid,
+        const std::uint64_t fuseFileHandleId, const off_t offset,
+        std::shared_ptr<folly::IOBuf> buf,
+        const int retriesLeft = FSLOGIC_RETRY_COUNT,
+        std::unique_ptr<IOTraceWrite> ioTraceEntry = {});
+
+    /**
+     * Stores written data in the write-back journal of a file handle and
+     * schedules its upload to the storage in background. Falls back to
+     * @c writeThrough when the dirty data limits are exceeded.
+     * @see write
+     */
+    std::size_t writeBack(const folly::fbstring &uuid,
+        const std::uint64_t fuseFileHandleId, const off_t offset,
+        std::shared_ptr<folly::IOBuf> buf);
+
+    /**
+     * Uploads all data stored in the write-back journal of a file handle to
+     * the storage. Entries left in the journal by a failed background upload
+     * are retried first and its error is rethrown afterwards.
+     * @param fuseFileHandle The file handle.
+     */
+    void uploadWriteBackJournal(
+        const std::shared_ptr<FuseFileHandle> &fuseFileHandle);
+
+    /**
+     * Uploads write-back journals of a file in all open handles. Data of a
+     * file is journaled by one handle at a time, so that the writes reach
+     * the storage in the order in which they were made.
+     * @param uuid Uuid of the file.
+     */
+    void uploadWriteBackJournals(const folly::fbstring &uuid);
+
+    /**
+     * Uploads the write-back journal of a file held by a handle other than
+     * the specified one, before data is written through that handle.
+     * @param uuid Uuid of the file.
+     * @param fuseFileHandleId Id of the handle about to write the file.
+     */
+    void uploadOtherWriteBackJournals(
+        const folly::fbstring &uuid, const std::uint64_t fuseFileHandleId);
+
+    /**
+     * Uploads write-back journals of a file and publishes write extents
+     * accumulated for it in all open handles.
+     * @param uuid Uuid of the file.
+     * @returns true if any write extent has been published.
+     */
+    bool publishPendingWrites(const folly::fbstring &uuid);
+
+    /**
+     * Schedules publication of the extents older than
+     * @c FSLOGIC_PENDING_EXTENT_MAX_AGE, unless it is already scheduled.
+     */
+    void schedulePendingExtentsPublish();
+
+    /**
+     * Publishes extents older than @c FSLOGIC_PENDING_EXTENT_MAX_AGE from
+     * all open handles and reschedules itself while any extent remains.
+     */
+    void publishExpiredPendingExtents();
+
+    /**
+     * Schedules eviction of helper handles pooled for longer than
+     * @c FSLOGIC_HELPER_HANDLE_POOL_GRACE_PERIOD, unless it is already
+     * scheduled.
+     */
+    void scheduleHelperHandlePoolPrune();
+
+    /**
+     * Evicts expired helper handles from the pool and reschedules itself
+     * while any handle remains pooled.
+     */
+    void pruneHelperHandlePool();
+
+    /**
+     * Returns a helper handle for I/O on a file block. The path to a
+     * directly accessible storage is chosen by the IO path selector when the
+     * file handle first accesses the storage and is kept until the handle is
+     * released. If the circuit breaker of the storage is open at that time,
+     * proxy IO is chosen instead, unless direct IO is forced. Later direct
+     * requests fail fast while the breaker is open.
+     * @returns The helper handle and the path through which it accesses the
+     * storage, if the storage is directly accessible.
+     */
+    std::pair<helpers::FileHandlePtr, folly::Optional<IOPath>>
+    getStorageHelperHandle(
+        const std::shared_ptr<FuseFileHandle> &fuseFileHandle,
+        const folly::fbstring &uuid, const folly::fbstring &spaceId,
+        const messages::fuse::FileBlock &fileBlock);
+
+    /**
+     * Waits for an operation on a helper handle, feeding its result and
+     * latency to the storage health tracker if the storage is accessed
+     * directly, and to the IO path selector if the storage is directly
+     * accessible.
+     */
+    template <typename T>
+    T waitForStorage(const folly::fbstring &storageId,
+        const folly::Optional<IOPath> path,
+        const helpers::FileHandlePtr &helperHandle, folly::Future<T> future);
+
+    /**
+     * Starts storage access detection for all mounted spaces, so that it
+     * doesn't delay the first access to each of them. Spaces are enumerated
+     * until @c FSLOGIC_STORAGE_DETECTION_DEADLINE passes.
+     */
+    void detectStorages();
+
+    /**
+     * Resolves paths listed in the metadata warmup manifest in background,
+     * populating the metadata and readdir caches. The number of resolved
+     * paths is limited to the metadata cache size.
+     * @param manifestPath Path of the manifest file.
+     */
+    void warmupMetadata(const boost::filesystem::path &manifestPath);
+
+    /**
+     * Starts fibers resolving queued metadata warmup items, up to
+     * @c FSLOGIC_METADATA_WARMUP_CONCURRENCY of them. The last finishing
+     * fiber reports the warmup results.
+     * @param state The warmup state.
+     */
+    void spawnMetadataWarmupWorkers(
+        std::shared_ptr<MetadataWarmupState> state);
+
+    /**
+     * Resolves a single metadata warmup item, queueing the items for the
+     * next path component or for the entries matching a pattern.
+     * @param state The warmup state.
+     * @param item The item.
+     */
+    void warmupMetadataItem(
+        MetadataWarmupState &state, const MetadataWarmupItem &item);
+
+    /**
+     * Wraps @c m_runInFiber so that it can be safely called from other
+     * threads after this object has been destroyed, in which case the
+     * function is dropped.
+     * @returns Guarded function running its argument in the fslogic fiber.
+     */
+    std::function<void(folly::Function<void()>)> guardedRunInFiber();
+
+    /**
+     * Emits the @c FileRead event for the read extent accumulated in a file
+     * handle, if any.
+     * @param fuseFileHandle The file handle.
+     */
+    void publishPendingRead(
+        const std::shared_ptr<FuseFileHandle> &fuseFileHandle);
+
+    /**
+     * Emits the @c FileRead event for a read extent.
+     * @param pendingRead Read range along with the number of reads.
+     */
+    void publishRead(FuseFileHandle::PendingRead pendingRead);
+
     /**
      * Suspends current fiber for a random timed delay depending
-     * on current retry number.
+     * on current retry number, or on the health of the storage if given.
      * @param retriesLeft Current number of retries left
+     * @param storageId Id of the storage on which the operation failed
      */
-    void fiberRetryDelay(int retriesLeft);
+    void fiberRetryDelay(
+        int retriesLeft, const folly::fbstring &storageId = {});
 
     std::shared_ptr<Context> m_context;
     events::Manager m_eventManager{m_context};
     cache::LRUMetadataCache m_metadataCache;
     cache::ForceProxyIOCache m_forceProxyIOCache;
     std::unique_ptr<cache::HelpersCache> m_helpersCache;
+    cache::HelperHandlePool m_helperHandlePool;
+    StorageHealthTracker m_storageHealth;
+    IOPathSelector m_ioPathSelector;
     std::shared_ptr<cache::ReaddirCache> m_readdirCache;
     bool m_readEventsDisabled = false;
 
@@ -323,6 +556,14 @@ private:
     const std::chrono::seconds m_providerTimeout;
     std::function<void(folly::Function<void()>)> m_runInFiber;
 
+    // Shared with callbacks completing on other threads, cleared under the
+    // mutex in destructor
+    struct Liveness {
+        std::mutex mutex;
+        bool alive{true};
+    };
+    std::shared_ptr<Liveness> m_liveness{std::make_shared<Liveness>()};
+
     const bool m_prefetchModeAsync;
     const double m_linearReadPrefetchThreshold;
     const double m_randomReadPrefetchThreshold;
@@ -335,6 +576,28 @@ private:
     const bool m_ioTraceLoggerEnabled;
     const boost::optional<std::pair<std::string, std::string>> m_tagOnCreate;
     const boost::optional<std::pair<std::string, std::string>> m_tagOnModify;
+    const std::size_t m_writeExtentBatchSize;
+    // Whether expired extents publication is armed, modified only in fiber
+    bool m_pendingExtentsPublishScheduled{false};
+    bool m_helperHandlePoolPruneScheduled{false};
+    const std::size_t m_maxAsyncReleases;
+    const bool m_fsyncOnRelease;
+    // Releases completed in background, modified only in fiber and awaited
+    // in destructor
+    struct AsyncRelease {
+        std::shared_ptr<FuseFileHandle> fuseFileHandle;
+        folly::Future<folly::Unit> future;
+    };
+    std::unordered_map<std::uint64_t, AsyncRelease> m_asyncReleases;
+    const boost::optional<boost::filesystem::path> m_writeBackDirectory;
+    const std::size_t m_writeBackFileDirtyLimit;
+    const std::size_t m_writeBackDirtyLimit;
+    const bool m_writeBackOnFlush;
+    // Number of bytes in all write-back journals, modified only in fiber
+    std::size_t m_writeBackDirtySize{0};
+    // Id of the file handle whose write-back journal holds data of a file
+    std::unordered_map<folly::fbstring, std::uint64_t> m_writeBackHandleIds;
+    const bool m_directorySubscriptions;
     const folly::fbstring m_rootUuid;
 
     std::shared_ptr<IOTraceLogger> m_ioTraceLogger;
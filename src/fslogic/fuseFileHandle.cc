@@ -9,6 +9,7 @@
 #include "fuseFileHandle.h"
 
 #include "cache/forceProxyIOCache.h"
+#include "cache/helperHandlePool.h"
 #include "cache/helpersCache.h"
 #include "helpers/logging.h"
 
@@ -47,17 +48,31 @@ FuseFileHandle::FuseFileHandle(const int flags_, folly::fbstring handleId,
 
 helpers::FileHandlePtr FuseFileHandle::getHelperHandle(
     const folly::fbstring &uuid, const folly::fbstring &spaceId,
-    const folly::fbstring &storageId, const folly::fbstring &fileId)
+    const folly::fbstring &storageId, const folly::fbstring &fileId,
+    const bool forceProxyIO_)
 {
-    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId);
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId)
+                << LOG_FARG(forceProxyIO_);
 
-    const bool forceProxyIO = m_forceProxyIOCache.contains(uuid);
+    const bool forceProxyIO =
+        forceProxyIO_ || m_forceProxyIOCache.contains(uuid);
     const auto key = std::make_tuple(storageId, fileId, forceProxyIO);
 
     auto it = m_helperHandles.find(key);
     if (it != m_helperHandles.end())
         return it->second;
 
+    const auto filteredFlags = m_flags & (~O_CREAT) & (~O_APPEND);
+
+    if (m_helperHandlePool != nullptr && !forceProxyIO) {
+        auto handle =
+            m_helperHandlePool->take(storageId, fileId, filteredFlags);
+        if (handle) {
+            m_helperHandles[key] = handle;
+            return handle;
+        }
+    }
+
     auto helper =
         m_helpersCache.get(uuid, spaceId, storageId, forceProxyIO).get();
 
@@ -67,8 +82,6 @@ helpers::FileHandlePtr FuseFileHandle::getHelperHandle(
         throw std::errc::resource_unavailable_try_again; // NOLINT
     }
 
-    const auto filteredFlags = m_flags & (~O_CREAT) & (~O_APPEND);
-
     auto handle = communication::wait(
         helper->open(fileId, filteredFlags, makeParameters(uuid)),
         m_providerTimeout);
@@ -92,6 +105,40 @@ void FuseFileHandle::releaseHelperHandle(const folly::fbstring &uuid,
     }
 }
 
+folly::fbvector<helpers::FileHandlePtr> FuseFileHandle::poolHelperHandles(
+    const folly::fbstring &uuid)
+{
+    LOG_FCALL() << LOG_FARG(uuid);
+
+    folly::fbvector<helpers::FileHandlePtr> pooled;
+
+    if (m_helperHandlePool == nullptr || !m_helperHandlePool->enabled())
+        return pooled;
+
+    const auto filteredFlags = m_flags & (~O_CREAT) & (~O_APPEND);
+
+    for (auto it = m_helperHandles.begin(); it != m_helperHandles.end();) {
+        const auto &storageId = std::get<0>(it->first);
+        const auto &fileId = std::get<1>(it->first);
+        const bool forceProxyIO = std::get<2>(it->first);
+
+        // Proxy IO handles are bound to the Oneprovider handle of this open
+        if (forceProxyIO ||
+            m_helpersCache.getAccessType(storageId) !=
+                cache::HelpersCache::AccessType::DIRECT ||
+            !m_helperHandlePool->put(
+                uuid, storageId, fileId, filteredFlags, it->second)) {
+            ++it;
+            continue;
+        }
+
+        pooled.emplace_back(it->second);
+        it = m_helperHandles.erase(it);
+    }
+
+    return pooled;
+}
+
 folly::fbvector<helpers::FileHandlePtr> FuseFileHandle::helperHandles() const
 {
     folly::fbvector<helpers::FileHandlePtr> result;
@@ -153,6 +200,102 @@ bool FuseFileHandle::shouldCalculatePrefetch()
     return false;
 }
 
+folly::Optional<FuseFileHandle::PendingWrite> FuseFileHandle::addPendingWrite(
+    const folly::fbstring &uuid,
+    const boost::icl::discrete_interval<off_t> &range,
+    messages::fuse::FileBlock fileBlock)
+{
+    if (m_pendingWrite && m_pendingWrite->uuid == uuid &&
+        m_pendingWrite->fileBlock.storageId() == fileBlock.storageId() &&
+        m_pendingWrite->fileBlock.fileId() == fileBlock.fileId() &&
+        (boost::icl::intersects(m_pendingWrite->range, range) ||
+            boost::icl::touches(m_pendingWrite->range, range) ||
+            boost::icl::touches(range, m_pendingWrite->range))) {
+        m_pendingWrite->range = boost::icl::hull(m_pendingWrite->range, range);
+        return {};
+    }
+
+    auto previousWrite = takePendingWrite();
+    m_pendingWrite = PendingWrite{
+        uuid, range, std::move(fileBlock), std::chrono::steady_clock::now()};
+    return previousWrite;
+}
+
+folly::Optional<FuseFileHandle::PendingWrite>
+FuseFileHandle::takePendingWrite()
+{
+    folly::Optional<PendingWrite> pendingWrite;
+    std::swap(pendingWrite, m_pendingWrite);
+    return pendingWrite;
+}
+
+std::size_t FuseFileHandle::pendingWriteSize() const
+{
+    if (!m_pendingWrite)
+        return 0;
+
+    return boost::icl::size(m_pendingWrite->range);
+}
+
+bool FuseFileHandle::hasPendingWrite(const folly::fbstring &uuid) const
+{
+    return m_pendingWrite && m_pendingWrite->uuid == uuid;
+}
+
+folly::Optional<std::chrono::steady_clock::time_point>
+FuseFileHandle::pendingWriteSince() const
+{
+    if (!m_pendingWrite)
+        return {};
+
+    return m_pendingWrite->since;
+}
+
+folly::Optional<FuseFileHandle::PendingRead> FuseFileHandle::addPendingRead(
+    const folly::fbstring &uuid,
+    const boost::icl::discrete_interval<off_t> &range)
+{
+    if (m_pendingRead && m_pendingRead->uuid == uuid &&
+        (boost::icl::intersects(m_pendingRead->range, range) ||
+            boost::icl::touches(m_pendingRead->range, range) ||
+            boost::icl::touches(range, m_pendingRead->range))) {
+        m_pendingRead->range = boost::icl::hull(m_pendingRead->range, range);
+        m_pendingRead->size += boost::icl::size(range);
+        ++m_pendingRead->counter;
+        return {};
+    }
+
+    auto previousRead = takePendingRead();
+    m_pendingRead = PendingRead{uuid, range, 1,
+        static_cast<std::size_t>(boost::icl::size(range)),
+        std::chrono::steady_clock::now()};
+    return previousRead;
+}
+
+folly::Optional<FuseFileHandle::PendingRead> FuseFileHandle::takePendingRead()
+{
+    folly::Optional<PendingRead> pendingRead;
+    std::swap(pendingRead, m_pendingRead);
+    return pendingRead;
+}
+
+std::size_t FuseFileHandle::pendingReadSize() const
+{
+    if (!m_pendingRead)
+        return 0;
+
+    return m_pendingRead->size;
+}
+
+folly::Optional<std::chrono::steady_clock::time_point>
+FuseFileHandle::pendingReadSince() const
+{
+    if (!m_pendingRead)
+        return {};
+
+    return m_pendingRead->since;
+}
+
 } // namespace fslogic
 } // namespace client
 } // namespace one
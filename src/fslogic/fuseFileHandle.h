@@ -11,6 +11,11 @@
 #include "cache/lruMetadataCache.h"
 #include "communication/communicator.h"
 #include "helpers/storageHelper.h"
+#include "ioPathSelector.h"
+#include "messages/fuse/fileBlock.h"
+#include "writeBackJournal.h"
+
+#include <boost/icl/discrete_interval.hpp>
 
 #include <folly/EvictingCacheMap.h>
 #include <folly/FBString.h>
@@ -20,6 +25,7 @@
 #include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 
+#include <chrono>
 #include <unordered_map>
 
 namespace one {
@@ -27,6 +33,7 @@ namespace client {
 
 namespace cache {
 class HelpersCache;
+class HelperHandlePool;
 class ForceProxyIOCache;
 } // namespace cache
 
@@ -37,6 +44,29 @@ namespace fslogic {
  */
 class FuseFileHandle {
 public:
+    /**
+     * Contiguous range written through the handle, which has not yet been
+     * published to the metadata cache and the events stream.
+     */
+    struct PendingWrite {
+        folly::fbstring uuid;
+        boost::icl::discrete_interval<off_t> range;
+        messages::fuse::FileBlock fileBlock;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    /**
+     * Contiguous range read through the handle, which has not yet been
+     * published to the events stream.
+     */
+    struct PendingRead {
+        folly::fbstring uuid;
+        boost::icl::discrete_interval<off_t> range;
+        std::size_t counter;
+        std::size_t size;
+        std::chrono::steady_clock::time_point since;
+    };
+
     /**
      * Constructor.
      * @param flags Open flags mask.
@@ -61,11 +91,13 @@ public:
      * @param spaceId Id of the space for which the helper should be returned.
      * @param storageId ID of the storage of the file.
      * @param fileId ID of a file on the storage.
+     * @param forceProxyIO Determines whether to return a ProxyIO handle,
+     * regardless of the file being in the force proxy IO cache.
      * @returns A new or cached file handle for the location.
      */
     helpers::FileHandlePtr getHelperHandle(const folly::fbstring &uuid,
         const folly::fbstring &spaceId, const folly::fbstring &storageId,
-        const folly::fbstring &fileId);
+        const folly::fbstring &fileId, const bool forceProxyIO = false);
 
     /**
      * Releases an open helper handle for a file.
@@ -78,6 +110,47 @@ public:
     void releaseHelperHandle(const folly::fbstring &uuid,
         const folly::fbstring &storageId, const folly::fbstring &fileId);
 
+    /**
+     * Moves direct IO helper handles of the file to the helper handle pool,
+     * if one has been set, so that they can be reused by subsequent opens.
+     * Pooled handles are no longer returned by @c helperHandles .
+     * @param uuid Uuid of the file.
+     * @returns The pooled helper handles.
+     */
+    folly::fbvector<helpers::FileHandlePtr> poolHelperHandles(
+        const folly::fbstring &uuid);
+
+    /**
+     * Sets the pool from which helper handles are reused and to which they
+     * are returned on release.
+     */
+    void setHelperHandlePool(cache::HelperHandlePool *helperHandlePool)
+    {
+        m_helperHandlePool = helperHandlePool;
+    }
+
+    /**
+     * @param storageId Id of the storage.
+     * @returns Path chosen for I/O to a storage through this handle, if any.
+     */
+    folly::Optional<IOPath> ioPath(const folly::fbstring &storageId) const
+    {
+        auto it = m_ioPaths.find(storageId);
+        if (it == m_ioPaths.end())
+            return {};
+
+        return it->second;
+    }
+
+    /**
+     * Sets the path for I/O to a storage through this handle, so that the
+     * data isn't interleaved between direct and proxy helper handles.
+     */
+    void setIOPath(const folly::fbstring &storageId, const IOPath path)
+    {
+        m_ioPaths[storageId] = path;
+    }
+
     /**
      * @returns Open flags with which the handle was created.
      */
@@ -127,6 +200,87 @@ public:
 
     bool isOnModifyTagSet() { return m_tagOnModifySet; }
 
+    /**
+     * Coalesces a written range with the pending write extent.
+     * @param uuid Uuid of the file.
+     * @param range Written range.
+     * @param fileBlock Block to which the range has been written.
+     * @returns Previously pending extent, if the written range could not be
+     * merged with it and has to be published first.
+     */
+    folly::Optional<PendingWrite> addPendingWrite(const folly::fbstring &uuid,
+        const boost::icl::discrete_interval<off_t> &range,
+        messages::fuse::FileBlock fileBlock);
+
+    /**
+     * Removes the pending write extent from the handle.
+     * @returns Pending write extent, if any.
+     */
+    folly::Optional<PendingWrite> takePendingWrite();
+
+    /**
+     * @returns Size of the pending write extent in bytes.
+     */
+    std::size_t pendingWriteSize() const;
+
+    /**
+     * @returns true if the handle holds a pending write extent for a file.
+     */
+    bool hasPendingWrite(const folly::fbstring &uuid) const;
+
+    /**
+     * @returns Time at which the pending write extent has been started, if
+     * the handle holds one.
+     */
+    folly::Optional<std::chrono::steady_clock::time_point>
+    pendingWriteSince() const;
+
+    /**
+     * Coalesces a read range with the pending read extent.
+     * @param uuid Uuid of the file.
+     * @param range Read range.
+     * @returns Previously pending extent, if the read range could not be
+     * merged with it and has to be published first.
+     */
+    folly::Optional<PendingRead> addPendingRead(const folly::fbstring &uuid,
+        const boost::icl::discrete_interval<off_t> &range);
+
+    /**
+     * Removes the pending read extent from the handle.
+     * @returns Pending read extent, if any.
+     */
+    folly::Optional<PendingRead> takePendingRead();
+
+    /**
+     * @returns Number of bytes read in the pending read extent, including
+     * repeated reads of the same range.
+     */
+    std::size_t pendingReadSize() const;
+
+    /**
+     * @returns Time at which the pending read extent has been started, if
+     * the handle holds one.
+     */
+    folly::Optional<std::chrono::steady_clock::time_point>
+    pendingReadSince() const;
+
+    /**
+     * @returns Write-back journal of the handle, or nullptr if no data has
+     * been written in write-back mode.
+     */
+    WriteBackJournal *writeBackJournal() const
+    {
+        return m_writeBackJournal.get();
+    }
+
+    /**
+     * Sets the write-back journal of the handle.
+     */
+    void setWriteBackJournal(std::unique_ptr<WriteBackJournal> journal)
+    {
+        m_writeBackJournal = std::move(journal);
+    }
+
 private:
     std::unordered_map<folly::fbstring, folly::fbstring> makeParameters(
         const folly::fbstring &uuid);
@@ -139,6 +293,8 @@ private:
     std::unordered_map<std::tuple<folly::fbstring, folly::fbstring, bool>,
         helpers::FileHandlePtr>
         m_helperHandles;
+    // Paths chosen for I/O to directly accessible storages
+    std::unordered_map<folly::fbstring, IOPath> m_ioPaths;
     const std::chrono::seconds m_providerTimeout;
     boost::icl::discrete_interval<off_t> m_lastPrefetch;
     std::atomic<bool> m_fullPrefetchTriggered;
@@ -158,6 +314,18 @@ private:
     unsigned int m_readsSinceLastPrefetchCalculation;
     // Keeps the time of the last prefetch calculation
     std::chrono::system_clock::time_point m_timeOfLastPrefetchCalculation;
+
+    // Written range not yet published to file location and events stream
+    folly::Optional<PendingWrite> m_pendingWrite;
+
+    // Read range not yet published to events stream
+    folly::Optional<PendingRead> m_pendingRead;
+
+    // Data written in write-back mode, not yet uploaded to the storage
+    std::unique_ptr<WriteBackJournal> m_writeBackJournal;
+
+    // Pool of helper handles released by previous opens, if enabled
+    cache::HelperHandlePool *m_helperHandlePool{nullptr};
 };
 
 } // namespace fslogic
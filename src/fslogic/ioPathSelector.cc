@@ -0,0 +1,139 @@
+/**
+ * @file ioPathSelector.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "ioPathSelector.h"
+
+#include "helpers/logging.h"
+#include "monitoring/monitoring.h"
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+namespace {
+// Weight of the latest sample in the moving average of cost
+constexpr double IO_PATH_COST_WEIGHT = 0.2;
+
+// Operations smaller than this are dominated by latency, so they are
+// normalized as if they transferred this amount of data
+constexpr std::size_t IO_PATH_MIN_SAMPLE_SIZE = 64 * 1024;
+
+constexpr double IO_PATH_COST_UNIT = 1024 * 1024;
+
+const char *toString(const IOPath path)
+{
+    return path == IOPath::DIRECT ? "direct" : "proxy";
+}
+} // namespace
+
+IOPathSelector::IOPathSelector(const double probeRatio)
+    : m_probeRatio{std::min(std::max(probeRatio, 0.0), 1.0)}
+{
+}
+
+IOPath IOPathSelector::choose(const folly::fbstring &storageId)
+{
+    if (!enabled())
+        return IOPath::DIRECT;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    const auto preferred = m_storages[storageId].preferred;
+
+    std::bernoulli_distribution probe{m_probeRatio};
+    if (!probe(m_random))
+        return preferred;
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fslogic.storages.iopath.probes");
+
+    return preferred == IOPath::DIRECT ? IOPath::PROXY : IOPath::DIRECT;
+}
+
+void IOPathSelector::recordSample(const folly::fbstring &storageId,
+    const IOPath path, const std::size_t bytes,
+    const std::chrono::microseconds duration)
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto &paths = m_storages[storageId];
+    auto &stats = paths.stats(path);
+
+    const auto costUs = static_cast<double>(duration.count()) *
+        IO_PATH_COST_UNIT / std::max(bytes, IO_PATH_MIN_SAMPLE_SIZE);
+
+    stats.costUs = stats.costUs
+        ? (1 - IO_PATH_COST_WEIGHT) * *stats.costUs +
+            IO_PATH_COST_WEIGHT * costUs
+        : costUs;
+    ++stats.samples;
+
+    const auto alternative =
+        paths.preferred == IOPath::DIRECT ? IOPath::PROXY : IOPath::DIRECT;
+    const auto &preferredStats = paths.stats(paths.preferred);
+    const auto &alternativeStats = paths.stats(alternative);
+
+    if (preferredStats.samples < IO_PATH_MIN_SAMPLES ||
+        alternativeStats.samples < IO_PATH_MIN_SAMPLES)
+        return;
+
+    if (*alternativeStats.costUs * IO_PATH_SWITCH_HYSTERESIS >=
+        *preferredStats.costUs)
+        return;
+
+    LOG(INFO) << "Switching I/O to storage " << storageId << " from "
+              << toString(paths.preferred) << " to " << toString(alternative)
+              << " path (" << static_cast<std::size_t>(*preferredStats.costUs)
+              << "us/MiB vs "
+              << static_cast<std::size_t>(*alternativeStats.costUs)
+              << "us/MiB)";
+
+    paths.preferred = alternative;
+    if (alternative == IOPath::PROXY)
+        ++m_proxiedStorages;
+    else
+        --m_proxiedStorages;
+
+    ONE_METRIC_COUNTER_INC(
+        "comp.oneclient.mod.fslogic.storages.iopath.switches");
+    ONE_METRIC_COUNTER_SET(
+        "comp.oneclient.mod.fslogic.storages.iopath.proxied",
+        m_proxiedStorages);
+}
+
+IOPath IOPathSelector::preferredPath(const folly::fbstring &storageId) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end())
+        return IOPath::DIRECT;
+
+    return it->second.preferred;
+}
+
+folly::Optional<double> IOPathSelector::cost(
+    const folly::fbstring &storageId, const IOPath path) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end())
+        return {};
+
+    return path == IOPath::DIRECT ? it->second.direct.costUs
+                                  : it->second.proxy.costUs;
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -0,0 +1,121 @@
+/**
+ * @file ioPathSelector.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+#include <folly/Optional.h>
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+/**
+ * Path through which I/O to a directly accessible storage is performed.
+ */
+enum class IOPath { DIRECT, PROXY };
+
+// Number of samples of both paths required before switching the path
+constexpr std::size_t IO_PATH_MIN_SAMPLES = 5;
+
+// Factor by which the alternative path has to be cheaper to switch to it
+constexpr double IO_PATH_SWITCH_HYSTERESIS = 1.2;
+
+/**
+ * @c IOPathSelector chooses, per storage, whether I/O to a directly
+ * accessible storage is faster through direct or proxy IO.
+ *
+ * The cost of each path is a moving average of the duration of operations
+ * normalized to the amount of transferred data, so that both latency and
+ * throughput are taken into account. A fraction of operations is routed
+ * through the path which is currently not preferred, to keep its cost up to
+ * date. The preferred path switches only once the alternative is
+ * significantly cheaper, to avoid flapping between the paths.
+ */
+class IOPathSelector {
+public:
+    /**
+     * Constructor.
+     * @param probeRatio Fraction of operations routed through the path which
+     * is not preferred, 0 disables switching from direct IO.
+     */
+    explicit IOPathSelector(const double probeRatio);
+
+    /**
+     * @returns true if switching between the paths is enabled.
+     */
+    bool enabled() const { return m_probeRatio > 0; }
+
+    /**
+     * Chooses the path for an operation on a storage.
+     * @param storageId Id of the storage.
+     * @returns The preferred path of the storage, or the alternative one if
+     * the operation has been sampled for probing.
+     */
+    IOPath choose(const folly::fbstring &storageId);
+
+    /**
+     * Records an operation performed on a storage, possibly switching its
+     * preferred path. Failed operations should be recorded with their
+     * duration until failure, which penalizes slow failures.
+     * @param storageId Id of the storage.
+     * @param path Path through which the operation was performed.
+     * @param bytes Number of transferred bytes.
+     * @param duration Duration of the operation.
+     */
+    void recordSample(const folly::fbstring &storageId, const IOPath path,
+        const std::size_t bytes, const std::chrono::microseconds duration);
+
+    /**
+     * @param storageId Id of the storage.
+     * @returns Currently preferred path of the storage.
+     */
+    IOPath preferredPath(const folly::fbstring &storageId) const;
+
+    /**
+     * @param storageId Id of the storage.
+     * @param path The path.
+     * @returns Moving average of the operation duration in microseconds per
+     * MiB through the path, if any operation has been recorded.
+     */
+    folly::Optional<double> cost(
+        const folly::fbstring &storageId, const IOPath path) const;
+
+private:
+    struct PathStats {
+        folly::Optional<double> costUs;
+        std::size_t samples{0};
+    };
+
+    struct StoragePaths {
+        IOPath preferred{IOPath::DIRECT};
+        PathStats direct;
+        PathStats proxy;
+
+        PathStats &stats(const IOPath path)
+        {
+            return path == IOPath::DIRECT ? direct : proxy;
+        }
+    };
+
+    const double m_probeRatio;
+
+    std::unordered_map<folly::fbstring, StoragePaths> m_storages;
+    std::size_t m_proxiedStorages{0};
+    std::minstd_rand m_random{std::random_device{}()};
+    mutable std::mutex m_mutex;
+};
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
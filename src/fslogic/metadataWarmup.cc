@@ -0,0 +1,83 @@
+/**
+ * @file metadataWarmup.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "metadataWarmup.h"
+
+#include "helpers/logging.h"
+
+#include <fnmatch.h>
+
+#include <string>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+std::vector<MetadataWarmupPath> parseMetadataWarmupManifest(
+    std::istream &manifest)
+{
+    std::vector<MetadataWarmupPath> paths;
+
+    std::string line;
+    while (std::getline(manifest, line)) {
+        const auto begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#')
+            continue;
+
+        const auto end = line.find_last_not_of(" \t\r");
+        const auto trimmed = line.substr(begin, end - begin + 1);
+
+        MetadataWarmupPath path;
+        bool valid = true;
+        std::size_t start = 0;
+        while (start <= trimmed.size()) {
+            auto separator = trimmed.find('/', start);
+            if (separator == std::string::npos)
+                separator = trimmed.size();
+
+            const auto component = trimmed.substr(start, separator - start);
+            start = separator + 1;
+
+            if (component.empty() || component == ".")
+                continue;
+
+            if (component == "..") {
+                valid = false;
+                break;
+            }
+
+            path.emplace_back(component);
+        }
+
+        if (!valid) {
+            LOG(WARNING) << "Skipping metadata warmup path '" << trimmed
+                         << "' with '..' component";
+            continue;
+        }
+
+        if (!path.empty())
+            paths.emplace_back(std::move(path));
+    }
+
+    return paths;
+}
+
+bool isMetadataWarmupPattern(const folly::fbstring &component)
+{
+    return component.find_first_of("*?[") != folly::fbstring::npos;
+}
+
+bool matchesMetadataWarmupPattern(
+    const folly::fbstring &pattern, const folly::fbstring &name)
+{
+    return fnmatch(pattern.c_str(), name.c_str(), FNM_PERIOD) == 0;
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -0,0 +1,77 @@
+/**
+ * @file metadataWarmup.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+
+#include <chrono>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+using MetadataWarmupPath = std::vector<folly::fbstring>;
+
+/**
+ * Single path component to be resolved during metadata warmup.
+ */
+struct MetadataWarmupItem {
+    // Uuid of the directory in which the component is resolved
+    folly::fbstring parentUuid;
+    // Name or wildcard pattern of the component
+    folly::fbstring name;
+    std::shared_ptr<const MetadataWarmupPath> path;
+    // Index of the component in the path
+    std::size_t depth;
+};
+
+/**
+ * Metadata warmup state, shared by the fibers resolving its items.
+ */
+struct MetadataWarmupState {
+    std::deque<MetadataWarmupItem> queue;
+    std::size_t workers{0};
+    std::size_t resolved{0};
+    std::size_t failed{0};
+    bool truncated{false};
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Parses a metadata warmup manifest, which lists one path relative to the
+ * mountpoint per line. Empty lines and lines starting with '#' are skipped,
+ * as are paths containing '..' components.
+ * @param manifest Stream with the manifest contents.
+ * @returns Paths split into non-empty components.
+ */
+std::vector<MetadataWarmupPath> parseMetadataWarmupManifest(
+    std::istream &manifest);
+
+/**
+ * @returns true if a path component contains wildcards.
+ */
+bool isMetadataWarmupPattern(const folly::fbstring &component);
+
+/**
+ * Matches a file name against a wildcard pattern of a path component, with
+ * leading dots matched only explicitly, as in the shell.
+ * @param pattern The pattern.
+ * @param name The file name.
+ * @returns true if the name matches the pattern.
+ */
+bool matchesMetadataWarmupPattern(
+    const folly::fbstring &pattern, const folly::fbstring &name);
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -0,0 +1,194 @@
+/**
+ * @file storageHealthTracker.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "storageHealthTracker.h"
+
+#include "helpers/logging.h"
+#include "monitoring/monitoring.h"
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+namespace {
+// Limits the exponent of the backoff and cooldown multipliers
+constexpr unsigned int STORAGE_HEALTH_MAX_EXPONENT = 16;
+
+// Weight of the latest sample in the moving average of latency
+constexpr double STORAGE_HEALTH_LATENCY_WEIGHT = 0.2;
+
+std::chrono::milliseconds exponentialDelay(
+    const std::chrono::milliseconds base, const unsigned int exponent)
+{
+    const std::chrono::milliseconds::rep multiplier = 1
+        << std::min(exponent, STORAGE_HEALTH_MAX_EXPONENT);
+
+    return std::min(STORAGE_HEALTH_MAX_RETRY_DELAY, base * multiplier);
+}
+} // namespace
+
+StorageHealthTracker::StorageHealthTracker(const unsigned int failureThreshold)
+    : m_failureThreshold{failureThreshold}
+{
+}
+
+void StorageHealthTracker::recordSuccess(
+    const folly::fbstring &storageId, const std::chrono::microseconds latency)
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto &health = m_storages[storageId];
+
+    const auto latencyUs = static_cast<double>(latency.count());
+    health.latencyUs = health.latencyUs
+        ? (1 - STORAGE_HEALTH_LATENCY_WEIGHT) * *health.latencyUs +
+            STORAGE_HEALTH_LATENCY_WEIGHT * latencyUs
+        : latencyUs;
+
+    health.consecutiveFailures = 0;
+    health.openings = 0;
+
+    if (health.state == BreakerState::CLOSED)
+        return;
+
+    LOG(INFO) << "Closing circuit breaker of storage " << storageId;
+
+    health.state = BreakerState::CLOSED;
+    --m_openBreakers;
+
+    ONE_METRIC_COUNTER_INC(
+        "comp.oneclient.mod.fslogic.storages.breaker.closed");
+    ONE_METRIC_COUNTER_SET(
+        "comp.oneclient.mod.fslogic.storages.breaker.open", m_openBreakers);
+}
+
+void StorageHealthTracker::recordFailure(const folly::fbstring &storageId)
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fslogic.storages.failures");
+
+    auto &health = m_storages[storageId];
+    ++health.consecutiveFailures;
+
+    if (m_failureThreshold == 0)
+        return;
+
+    // Failed probe opens the breaker again, failures of requests started
+    // before the breaker opened don't extend the cooldown
+    if (health.state == BreakerState::HALF_OPEN ||
+        (health.state == BreakerState::CLOSED &&
+            health.consecutiveFailures >= m_failureThreshold))
+        openBreaker(storageId, health);
+}
+
+bool StorageHealthTracker::allowRequest(const folly::fbstring &storageId)
+{
+    if (m_failureThreshold == 0)
+        return true;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end() || it->second.state == BreakerState::CLOSED)
+        return true;
+
+    auto &health = it->second;
+    const auto now = std::chrono::steady_clock::now();
+    if (now < health.retryAfter)
+        return false;
+
+    // Let a single probe through, another one is allowed only if the probe
+    // doesn't complete within the cooldown
+    LOG_DBG(1) << "Probing storage " << storageId
+               << " with open circuit breaker";
+
+    health.state = BreakerState::HALF_OPEN;
+    health.retryAfter = now + cooldown(health);
+    return true;
+}
+
+folly::Optional<std::chrono::milliseconds> StorageHealthTracker::retryDelay(
+    const folly::fbstring &storageId)
+{
+    if (m_failureThreshold == 0)
+        return {};
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end() || it->second.consecutiveFailures == 0)
+        return {};
+
+    const auto maxDelay = exponentialDelay(STORAGE_HEALTH_MIN_RETRY_DELAY,
+        it->second.consecutiveFailures - 1);
+
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> delay{
+        STORAGE_HEALTH_MIN_RETRY_DELAY.count(), maxDelay.count()};
+
+    return std::chrono::milliseconds{delay(m_random)};
+}
+
+StorageHealthTracker::BreakerState StorageHealthTracker::breakerState(
+    const folly::fbstring &storageId) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end())
+        return BreakerState::CLOSED;
+
+    return it->second.state;
+}
+
+folly::Optional<std::chrono::microseconds> StorageHealthTracker::latency(
+    const folly::fbstring &storageId) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    auto it = m_storages.find(storageId);
+    if (it == m_storages.end() || !it->second.latencyUs)
+        return {};
+
+    return std::chrono::microseconds{
+        static_cast<std::chrono::microseconds::rep>(*it->second.latencyUs)};
+}
+
+void StorageHealthTracker::openBreaker(
+    const folly::fbstring &storageId, StorageHealth &health)
+{
+    if (health.state == BreakerState::CLOSED) {
+        ++m_openBreakers;
+        ONE_METRIC_COUNTER_SET(
+            "comp.oneclient.mod.fslogic.storages.breaker.open", m_openBreakers);
+    }
+
+    ++health.openings;
+    health.state = BreakerState::OPEN;
+    health.retryAfter = std::chrono::steady_clock::now() + cooldown(health);
+
+    LOG(WARNING) << "Opening circuit breaker of storage " << storageId
+                 << " for " << cooldown(health).count() << "ms after "
+                 << health.consecutiveFailures << " consecutive failures";
+
+    ONE_METRIC_COUNTER_INC(
+        "comp.oneclient.mod.fslogic.storages.breaker.opened");
+}
+
+std::chrono::milliseconds StorageHealthTracker::cooldown(
+    const StorageHealth &health) const
+{
+    return exponentialDelay(STORAGE_BREAKER_MIN_COOLDOWN,
+        health.openings > 0 ? health.openings - 1 : 0);
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
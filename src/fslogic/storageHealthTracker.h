@@ -0,0 +1,119 @@
+/**
+ * @file storageHealthTracker.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+#include <folly/Optional.h>
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+constexpr std::chrono::milliseconds STORAGE_HEALTH_MIN_RETRY_DELAY{100};
+constexpr std::chrono::milliseconds STORAGE_HEALTH_MAX_RETRY_DELAY{30'000};
+constexpr std::chrono::milliseconds STORAGE_BREAKER_MIN_COOLDOWN{1'000};
+
+/**
+ * @c StorageHealthTracker keeps track of the health of storages accessed
+ * directly, based on the results and latencies of helper operations.
+ *
+ * Consecutive failures of a storage drive an exponential retry backoff with
+ * jitter, shared by all operations on the storage. After the number of
+ * consecutive failures reaches the threshold, the circuit breaker of the
+ * storage opens and requests to it are rejected for a cooldown period, which
+ * doubles each time the breaker opens again without a successful request in
+ * between. After the cooldown a single probe request is let through, which
+ * either closes the breaker or opens it again.
+ */
+class StorageHealthTracker {
+public:
+    enum class BreakerState { CLOSED, OPEN, HALF_OPEN };
+
+    /**
+     * Constructor.
+     * @param failureThreshold Number of consecutive failures after which the
+     * circuit breaker of a storage opens, 0 disables the breaker.
+     */
+    explicit StorageHealthTracker(const unsigned int failureThreshold);
+
+    /**
+     * Records a successful operation on a storage, closing its breaker.
+     * @param storageId Id of the storage.
+     * @param latency Duration of the operation.
+     */
+    void recordSuccess(const folly::fbstring &storageId,
+        const std::chrono::microseconds latency);
+
+    /**
+     * Records a failed operation on a storage.
+     * @param storageId Id of the storage.
+     */
+    void recordFailure(const folly::fbstring &storageId);
+
+    /**
+     * Checks whether a request to a storage should be performed. After the
+     * breaker cooldown passes, the request becomes a probe of the storage.
+     * @param storageId Id of the storage.
+     * @returns false if the breaker of the storage is open.
+     */
+    bool allowRequest(const folly::fbstring &storageId);
+
+    /**
+     * @param storageId Id of the storage.
+     * @returns Random delay before retrying an operation on a storage, with
+     * the upper bound growing exponentially with the number of consecutive
+     * failures of the storage, or none if the breaker is disabled or no
+     * failures of the storage have been recorded.
+     */
+    folly::Optional<std::chrono::milliseconds> retryDelay(
+        const folly::fbstring &storageId);
+
+    /**
+     * @param storageId Id of the storage.
+     * @returns Current state of the breaker of the storage.
+     */
+    BreakerState breakerState(const folly::fbstring &storageId) const;
+
+    /**
+     * @param storageId Id of the storage.
+     * @returns Moving average of successful operations latency, if any
+     * operation on the storage has succeeded.
+     */
+    folly::Optional<std::chrono::microseconds> latency(
+        const folly::fbstring &storageId) const;
+
+private:
+    struct StorageHealth {
+        unsigned int consecutiveFailures{0};
+        unsigned int openings{0};
+        BreakerState state{BreakerState::CLOSED};
+        std::chrono::steady_clock::time_point retryAfter;
+        folly::Optional<double> latencyUs;
+    };
+
+    // All require m_mutex to be held
+    void openBreaker(const folly::fbstring &storageId, StorageHealth &health);
+    std::chrono::milliseconds cooldown(const StorageHealth &health) const;
+
+    const unsigned int m_failureThreshold;
+
+    std::unordered_map<folly::fbstring, StorageHealth> m_storages;
+    std::size_t m_openBreakers{0};
+    std::minstd_rand m_random{std::random_device{}()};
+    mutable std::mutex m_mutex;
+};
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
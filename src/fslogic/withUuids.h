@@ -10,9 +10,11 @@
 
 #include "attrs.h"
 #include "cache/inodeCache.h"
+#include "context.h"
 #include "helpers/logging.h"
 #include "ioTraceLogger.h"
 #include "messages/fuse/fileAttr.h"
+#include "options/options.h"
 
 #include <folly/FBString.h>
 #include <folly/io/IOBufQueue.h>
@@ -37,11 +39,18 @@ constexpr auto WITHUUIDS_RETRY_COUNT = 4;
 template <typename FsLogicT> class WithUuids {
 public:
     template <typename... Args>
-    WithUuids(folly::fbstring rootUuid, Args &&... args)
-        : m_inodeCache{std::move(rootUuid)}
-        , m_generation{std::chrono::system_clock::to_time_t(
-              std::chrono::system_clock::now())}
-        , m_fsLogic{std::forward<Args>(args)...}
+    WithUuids(folly::fbstring rootUuid, std::shared_ptr<Context> context,
+        Args &&... args)
+        : m_inodeCache{std::move(rootUuid), cache::DEFAULT_INODE_CACHE_SIZE,
+              context->options()->areDeterministicInodesEnabled()}
+        , m_deterministicInodes{
+              context->options()->areDeterministicInodesEnabled()}
+        // Inodes are only stable across remounts along with their generation
+        , m_generation{m_deterministicInodes
+                  ? 0
+                  : std::chrono::system_clock::to_time_t(
+                        std::chrono::system_clock::now())}
+        , m_fsLogic{std::move(context), std::forward<Args>(args)...}
     {
         m_fsLogic.onMarkDeleted(std::bind(&cache::InodeCache::markDeleted,
             &m_inodeCache, std::placeholders::_1));
@@ -242,7 +251,11 @@ private:
     struct fuse_entry_param toEntry(const FileAttrPtr attr)
     {
         struct fuse_entry_param entry = {0};
-        entry.generation = m_generation;
+        // Deterministic inodes can be reused for different files, which are
+        // told apart by generations derived from their uuids
+        entry.generation = m_deterministicInodes
+            ? cache::InodeCache::generation(attr->uuid())
+            : m_generation;
         entry.ino = m_inodeCache.lookup(attr->uuid());
         entry.attr = detail::toStatbuf(attr, entry.ino);
 
@@ -250,6 +263,7 @@ private:
     }
 
     cache::InodeCache m_inodeCache;
+    const bool m_deterministicInodes;
     const long long m_generation;
     FsLogicT m_fsLogic;
 };
@@ -0,0 +1,135 @@
+/**
+ * @file writeBackJournal.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "writeBackJournal.h"
+
+#include "helpers/logging.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+namespace {
+std::system_error makeSystemError()
+{
+    return std::system_error{std::error_code(errno, std::system_category())};
+}
+} // namespace
+
+WriteBackJournal::WriteBackJournal(
+    const boost::filesystem::path &directory, std::uint64_t fuseFileHandleId)
+    : m_fuseFileHandleId{fuseFileHandleId}
+{
+    const auto path = directory /
+        boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.journal");
+
+    LOG_DBG(2) << "Creating write-back journal " << path.string()
+               << " for file handle " << fuseFileHandleId;
+
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (m_fd == -1) {
+        LOG(ERROR) << "Cannot create write-back journal " << path.string()
+                   << ": " << strerror(errno);
+        throw makeSystemError();
+    }
+
+    ::unlink(path.c_str());
+}
+
+WriteBackJournal::~WriteBackJournal()
+{
+    if (!m_entries.empty())
+        LOG(WARNING) << "Dropping " << m_dirtySize
+                     << " bytes not uploaded from write-back journal of file "
+                     << m_uuid;
+
+    ::close(m_fd);
+}
+
+void WriteBackJournal::append(
+    const folly::fbstring &uuid, const off_t offset, const folly::IOBuf &buf)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(offset)
+                << LOG_FARG(buf.computeChainDataLength());
+
+    const auto size = buf.computeChainDataLength();
+    auto journalOffset = m_journalSize;
+
+    for (const auto &range : buf) {
+        std::size_t written = 0;
+        while (written < range.size()) {
+            auto res = ::pwrite(m_fd, range.data() + written,
+                range.size() - written, journalOffset);
+            if (res == -1) {
+                if (errno == EINTR)
+                    continue;
+                throw makeSystemError();
+            }
+            written += res;
+            journalOffset += res;
+        }
+    }
+
+    m_uuid = uuid;
+    m_entries.emplace_back(Entry{offset, size, m_journalSize});
+    m_journalSize = journalOffset;
+    m_dirtySize += size;
+}
+
+std::shared_ptr<folly::IOBuf> WriteBackJournal::read(const Entry &entry) const
+{
+    std::shared_ptr<folly::IOBuf> buf = folly::IOBuf::create(entry.size);
+
+    std::size_t bytesRead = 0;
+    while (bytesRead < entry.size) {
+        auto res = ::pread(m_fd, buf->writableTail(), entry.size - bytesRead,
+            entry.journalOffset + bytesRead);
+        if (res == -1) {
+            if (errno == EINTR)
+                continue;
+            throw makeSystemError();
+        }
+        if (res == 0)
+            throw std::system_error{std::make_error_code(std::errc::io_error)};
+
+        buf->append(res);
+        bytesRead += res;
+    }
+
+    return buf;
+}
+
+void WriteBackJournal::popFront()
+{
+    m_dirtySize -= m_entries.front().size;
+    m_entries.pop_front();
+
+    // Reclaim the journal space once everything has been uploaded
+    if (m_entries.empty()) {
+        m_journalSize = 0;
+        if (::ftruncate(m_fd, 0) == -1)
+            LOG(WARNING) << "Cannot truncate write-back journal of file "
+                         << m_uuid << ": " << strerror(errno);
+    }
+}
+
+void WriteBackJournal::rethrowError()
+{
+    if (m_error) {
+        auto error = std::move(m_error);
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -0,0 +1,151 @@
+/**
+ * @file writeBackJournal.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+#include <folly/FBString.h>
+#include <folly/fibers/TimedMutex.h>
+#include <folly/io/IOBuf.h>
+
+#include <deque>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+/**
+ * @c WriteBackJournal stores data written through a single file handle in a
+ * local file, until it is uploaded to the storage in background. The journal
+ * file is unlinked right after creation, so it does not outlive the process.
+ */
+class WriteBackJournal {
+public:
+    /**
+     * Single write stored in the journal.
+     */
+    struct Entry {
+        off_t offset;
+        std::size_t size;
+        off_t journalOffset;
+    };
+
+    /**
+     * Constructor.
+     * Creates the journal file in a specified directory.
+     * @param directory Directory in which the journal file is created.
+     * @param fuseFileHandleId Id of the file handle owning the journal.
+     */
+    WriteBackJournal(
+        const boost::filesystem::path &directory, std::uint64_t fuseFileHandleId);
+
+    /**
+     * Destructor.
+     * Closes the journal file.
+     */
+    ~WriteBackJournal();
+
+    WriteBackJournal(const WriteBackJournal &) = delete;
+    WriteBackJournal &operator=(const WriteBackJournal &) = delete;
+
+    /**
+     * Appends written data to the journal.
+     * @param uuid Uuid of the file to which the data was written.
+     * @param offset Offset in the file at which the data was written.
+     * @param buf The written data.
+     */
+    void append(
+        const folly::fbstring &uuid, const off_t offset, const folly::IOBuf &buf);
+
+    /**
+     * Reads data of a journal entry.
+     * @param entry The journal entry.
+     * @returns Buffer with the entry data.
+     */
+    std::shared_ptr<folly::IOBuf> read(const Entry &entry) const;
+
+    /**
+     * @returns The oldest entry not yet uploaded to the storage.
+     */
+    const Entry &front() const { return m_entries.front(); }
+
+    /**
+     * Removes the oldest entry after it has been uploaded to the storage.
+     */
+    void popFront();
+
+    /**
+     * @returns true if all entries have been uploaded to the storage.
+     */
+    bool empty() const { return m_entries.empty(); }
+
+    /**
+     * @returns Number of bytes not yet uploaded to the storage.
+     */
+    std::size_t dirtySize() const { return m_dirtySize; }
+
+    /**
+     * @returns Uuid of the file to which the journaled data belongs.
+     */
+    const folly::fbstring &uuid() const { return m_uuid; }
+
+    /**
+     * @returns Id of the file handle owning the journal.
+     */
+    std::uint64_t fuseFileHandleId() const { return m_fuseFileHandleId; }
+
+    /**
+     * Mutex serializing uploads of the journal entries between the background
+     * upload and operations waiting for the journal to be drained.
+     */
+    folly::fibers::TimedMutex &uploadMutex() { return m_uploadMutex; }
+
+    /**
+     * Marks the background upload of the journal as scheduled.
+     * @returns false if the upload has already been scheduled.
+     */
+    bool scheduleUpload()
+    {
+        if (m_uploadScheduled)
+            return false;
+
+        m_uploadScheduled = true;
+        return true;
+    }
+
+    /**
+     * Marks the scheduled background upload of the journal as started.
+     */
+    void startUpload() { m_uploadScheduled = false; }
+
+    /**
+     * Stores the error of a failed upload, to be reported on the next
+     * operation on the file handle.
+     */
+    void setError(std::exception_ptr error) { m_error = std::move(error); }
+
+    /**
+     * Rethrows and clears the stored upload error, if any.
+     */
+    void rethrowError();
+
+private:
+    const std::uint64_t m_fuseFileHandleId;
+    int m_fd = -1;
+    folly::fbstring m_uuid;
+    std::deque<Entry> m_entries;
+    std::size_t m_dirtySize = 0;
+    off_t m_journalSize = 0;
+    std::exception_ptr m_error;
+    bool m_uploadScheduled = false;
+    folly::fibers::TimedMutex m_uploadMutex;
+};
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -34,6 +34,7 @@
 #include "options/options.h"
 #include "scheduler.h"
 #include "scopeExit.h"
+#include "util/timingWheel.h"
 #include "version.h"
 
 #include <folly/Singleton.h>
@@ -45,18 +46,70 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <exception>
 #include <future>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <regex>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace one;             // NOLINT
 using namespace one::client;     // NOLINT
 using namespace one::monitoring; // NOLINT
 
+/**
+ * @c StartupTimer measures the durations of mount startup phases. Each phase
+ * is logged when it completes, and all of them are reported as metrics once
+ * performance monitoring has been started.
+ */
+class StartupTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Records the completion of a phase.
+     * @param phase Name of the phase, used as the suffix of its metric.
+     * @param start Time at which the phase has started.
+     */
+    void finish(std::string phase, const Clock::time_point start)
+    {
+        const auto duration =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                Clock::now() - start);
+
+        LOG(INFO) << "Startup phase '" << phase << "' completed in "
+                  << duration.count() << "ms";
+
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_phases.emplace_back(std::move(phase), duration);
+    }
+
+    /**
+     * Records the completion of the whole startup and reports the
+     * durations of all phases as metrics.
+     */
+    void finishStartup()
+    {
+        finish("total", m_start);
+
+        std::lock_guard<std::mutex> guard{m_mutex};
+        for (const auto &phase : m_phases)
+            ONE_METRIC_COUNTER_SET(
+                "comp.oneclient.mod.startup." + phase.first,
+                phase.second.count());
+    }
+
+private:
+    const Clock::time_point m_start{Clock::now()};
+    std::vector<std::pair<std::string, std::chrono::milliseconds>> m_phases;
+    std::mutex m_mutex;
+};
+
 void startLogging(
     const char *programName, std::shared_ptr<options::Options> options)
 {
@@ -275,12 +328,29 @@ int main(int argc, char *argv[])
 
     startLogging(argv[0], options);
 
+    StartupTimer startupTimer;
+
     context->setScheduler(
         std::make_shared<Scheduler>(options->getSchedulerThreadCount()));
+    context->setTimingWheel(std::make_shared<util::TimingWheel>());
 
+    auto phaseStart = StartupTimer::Clock::now();
     auto authManager = getAuthManager(context);
     auto sessionId = generateSessionId();
-    auto configuration = getConfiguration(sessionId, authManager, context);
+    startupTimer.finish("authentication", phaseStart);
+
+    // Retrieve the configuration from the provider while the FUSE channel is
+    // set up, the configuration is required before daemonizing so that
+    // connection errors are reported to the user
+    auto configurationFuture = std::async(std::launch::async, [&] {
+        const auto start = StartupTimer::Clock::now();
+        auto configuration =
+            requestConfiguration(sessionId, authManager, context);
+        startupTimer.finish("configuration", start);
+        return configuration;
+    });
+
+    phaseStart = StartupTimer::Clock::now();
 
     auto fuse_oper = fuseOperations();
     auto args = options->getFuseArgs(argv[0]);
@@ -322,6 +392,18 @@ int main(int argc, char *argv[])
     fuse_session_add_chan(fuse, ch);
     ScopeExit removeChannel{[&] { fuse_session_remove_chan(ch); }};
 
+    startupTimer.finish("fuse", phaseStart);
+
+    std::shared_ptr<messages::Configuration> configuration;
+    try {
+        configuration = configurationFuture.get();
+    }
+    catch (const std::exception &e) {
+        LOG(ERROR) << "Failed to retrieve configuration: " << e.what();
+        std::cerr << "Connection refused - aborting..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
     std::cout << "Oneclient has been successfully mounted in '"
               << options->getMountpoint().c_str() << "'." << std::endl;
 
@@ -348,10 +430,17 @@ int main(int argc, char *argv[])
     if (startPerformanceMonitoring(options) != EXIT_SUCCESS)
         return EXIT_FAILURE;
 
+    phaseStart = StartupTimer::Clock::now();
     auto communicator = getCommunicator(sessionId, authManager, context);
     context->setCommunicator(communicator);
     communicator->connect();
+    startupTimer.finish("connection", phaseStart);
 
+    phaseStart = StartupTimer::Clock::now();
+
+    // Storage helpers are not pre-warmed here, FsLogic detects storages of
+    // all spaces in background only with --detect-storages-on-mount and
+    // otherwise creates each helper on the first access to its storage
     auto helpersCache = std::make_unique<cache::HelpersCache>(
         *communicator, *context->scheduler(), *options);
 
@@ -360,6 +449,9 @@ int main(int argc, char *argv[])
         std::move(configuration), std::move(helpersCache),
         options->getMetadataCacheSize(), options->areFileReadEventsDisabled(),
         options->isFullblockReadEnabled(), options->getProviderTimeout());
+    startupTimer.finish("fslogic", phaseStart);
+
+    startupTimer.finishStartup();
 
     res = (multithreaded != 0) ? fuse_session_loop_mt(fuse)
                                : fuse_session_loop(fuse);
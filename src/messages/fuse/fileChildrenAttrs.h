@@ -45,6 +45,11 @@ public:
         return m_childrenAttrs;
     }
 
+    /**
+     * @copydoc childrenAttrs() const
+     */
+    folly::fbvector<FileAttr> &childrenAttrs() { return m_childrenAttrs; }
+
     /**
      * @return Optional index token which contains id of the last returned
      *         item.
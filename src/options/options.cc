@@ -167,6 +167,57 @@ Options::Options()
         .withGroup(OptionGroup::ADVANCED)
         .withDescription("Force direct access to storage for all spaces.");
 
+    add<bool>()
+        ->asSwitch()
+        .withLongName("detect-storages-on-mount")
+        .withConfigName("detect_storages_on_mount")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Detect direct access to storages of all spaces in "
+                         "parallel right after mounting, instead of on first "
+                         "access to each storage.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("storage-access-state-file")
+        .withConfigName("storage_access_state_file")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Persist detected storage access types and "
+                         "mountpoints in the specified file, and reuse them "
+                         "on next mount while they are verified in "
+                         "background.");
+
+    add<unsigned int>()
+        ->withLongName("helper-params-refresh-interval")
+        .withConfigName("helper_params_refresh_interval")
+        .withValueName("<duration>")
+        .withDefaultValue(0, "0")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Proactively refresh storage helper parameters, "
+                         "such as temporary credentials, every specified "
+                         "number of seconds (0 disables).");
+
+    add<boost::filesystem::path>()
+        ->withLongName("metadata-warmup-manifest")
+        .withConfigName("metadata_warmup_manifest")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Resolve paths listed in the specified file, one per "
+                         "line relative to the mountpoint, in background "
+                         "right after mounting. Path components can contain "
+                         "'*', '?' and '[...]' wildcards.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("metadata-warmup-locations")
+        .withConfigName("metadata_warmup_locations")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Prefetch locations of regular files resolved "
+                         "during metadata warmup.");
+
     add<unsigned int>()
         ->withLongName("buffer-scheduler-thread-count")
         .withConfigName("buffer_scheduler_thread_count")
@@ -457,6 +508,165 @@ Options::Options()
         .withDescription("Specify the size of requests made during readdir "
                          "prefetch (in number of dir entries).");
 
+    add<unsigned int>()
+        ->withLongName("readdir-prefetch-fanout")
+        .withConfigName("readdir_prefetch_fanout")
+        .withValueName("<count>")
+        .withDefaultValue(DEFAULT_READDIR_PREFETCH_FANOUT,
+            std::to_string(DEFAULT_READDIR_PREFETCH_FANOUT))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify the maximum number of readdir prefetch "
+                         "requests issued in parallel for large directories "
+                         "(1 disables parallel prefetch).");
+
+    add<unsigned int>()
+        ->withLongName("write-extent-batch-size")
+        .withConfigName("write_extent_batch_size")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_WRITE_EXTENT_BATCH_SIZE,
+            std::to_string(DEFAULT_WRITE_EXTENT_BATCH_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify the size in bytes of contiguous writes "
+                         "accumulated per file handle before they are "
+                         "published to file location and events stream. 0 "
+                         "publishes each write immediately.");
+
+    add<unsigned int>()
+        ->withLongName("max-async-releases")
+        .withConfigName("max_async_releases")
+        .withValueName("<count>")
+        .withDefaultValue(DEFAULT_MAX_ASYNC_RELEASES,
+            std::to_string(DEFAULT_MAX_ASYNC_RELEASES))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum number of closed files, whose "
+                         "release is completed in background after close "
+                         "returns. 0 disables asynchronous release.");
+
+    add<unsigned int>()
+        ->withLongName("helper-handle-pool-size")
+        .withConfigName("helper_handle_pool_size")
+        .withValueName("<count>")
+        .withDefaultValue(DEFAULT_HELPER_HANDLE_POOL_SIZE,
+            std::to_string(DEFAULT_HELPER_HANDLE_POOL_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum number of direct IO storage handles "
+                         "kept open for a short time after file release, so "
+                         "that they can be reused when the file is opened "
+                         "again. 0 disables handle pooling.");
+
+    add<unsigned int>()
+        ->withLongName("storage-circuit-breaker-threshold")
+        .withConfigName("storage_circuit_breaker_threshold")
+        .withValueName("<count>")
+        .withDefaultValue(DEFAULT_STORAGE_CIRCUIT_BREAKER_THRESHOLD,
+            std::to_string(DEFAULT_STORAGE_CIRCUIT_BREAKER_THRESHOLD))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify number of consecutive failures of a "
+                         "directly accessed storage, after which its requests "
+                         "are routed through Oneprovider (or fail fast in "
+                         "forced direct IO mode) until the storage recovers. "
+                         "0 disables the circuit breaker.");
+
+    add<double>()
+        ->withLongName("io-path-probe-ratio")
+        .withConfigName("io_path_probe_ratio")
+        .withValueName("<fraction>")
+        .withDefaultValue(DEFAULT_IO_PATH_PROBE_RATIO,
+            std::to_string(DEFAULT_IO_PATH_PROBE_RATIO))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify the fraction of reads and writes to "
+                         "directly accessible storages, which are performed "
+                         "through the alternative of direct and proxy IO to "
+                         "measure its performance. IO to each storage is "
+                         "routed through the faster one. 0 disables "
+                         "switching (experimental).");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("no-fsync-on-release")
+        .withConfigName("no_fsync_on_release")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Disable provider fsync request on file release. "
+                         "File events are still flushed before the file is "
+                         "released.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("write-back-dir")
+        .withConfigName("write_back_dir")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Enables write-back mode, in which written data is "
+                         "stored in journals in the specified local directory "
+                         "and uploaded to the storage in background.");
+
+    add<std::size_t>()
+        ->withLongName("write-back-file-dirty-limit")
+        .withConfigName("write_back_file_dirty_limit")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_WRITE_BACK_FILE_DIRTY_LIMIT,
+            std::to_string(DEFAULT_WRITE_BACK_FILE_DIRTY_LIMIT))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum size in bytes of data not yet "
+                         "uploaded to the storage per file handle in "
+                         "write-back mode.");
+
+    add<std::size_t>()
+        ->withLongName("write-back-dirty-limit")
+        .withConfigName("write_back_dirty_limit")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_WRITE_BACK_DIRTY_LIMIT,
+            std::to_string(DEFAULT_WRITE_BACK_DIRTY_LIMIT))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum total size in bytes of data not yet "
+                         "uploaded to the storage in write-back mode.");
+
+    add<std::string>()
+        ->withLongName("write-back-durability")
+        .withConfigName("write_back_durability")
+        .withValueName("<mode>")
+        .withDefaultValue(
+            DEFAULT_WRITE_BACK_DURABILITY, DEFAULT_WRITE_BACK_DURABILITY)
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Defines when data written in write-back mode has "
+                         "to be uploaded to the storage. Possible values are: "
+                         "close (on each close and fsync), fsync (only on "
+                         "fsync, close returns before upload completes).");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("directory-subscriptions")
+        .withConfigName("directory_subscriptions")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Subscribe for attribute, removal and rename events "
+                         "of cached files through their parent directories, "
+                         "instead of separately for each file. Requires "
+                         "provider support for directory subscriptions.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("deterministic-inodes")
+        .withConfigName("deterministic_inodes")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Derive inode numbers from file UUIDs, so that they "
+                         "remain stable across remounts and between clients.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("metadata-cache-clock")
+        .withConfigName("metadata_cache_clock")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Evict file metadata from cache with the CLOCK "
+                         "algorithm, which only marks entries on access, "
+                         "instead of maintaining exact LRU order.");
+
     add<std::string>()
         ->withEnvName("tag_on_create")
         .withLongName("tag-on-create")
@@ -650,6 +860,12 @@ void Options::parse(const int argc, const char *const argv[])
     parser.parseEnvironment(m_deprecatedEnvs, m_vm);
     parser.parseConfigFile(getConfigFilePath(), m_vm);
     boost::program_options::notify(m_vm);
+
+    const auto writeBackDurability = getWriteBackDurability();
+    if (writeBackDurability != "close" && writeBackDurability != "fsync")
+        throw boost::program_options::validation_error{
+            boost::program_options::validation_error::invalid_option_value,
+            "write-back-durability", writeBackDurability};
 }
 
 std::string Options::formatDeprecated() const
@@ -788,6 +1004,40 @@ bool Options::isDirectIOForced() const
         .get_value_or(false);
 }
 
+bool Options::isStorageDetectionOnMountEnabled() const
+{
+    return get<bool>({"detect-storages-on-mount", "detect_storages_on_mount"})
+        .get_value_or(false);
+}
+
+boost::optional<boost::filesystem::path>
+Options::getStorageAccessStateFilePath() const
+{
+    return get<boost::filesystem::path>(
+        {"storage-access-state-file", "storage_access_state_file"});
+}
+
+boost::optional<boost::filesystem::path>
+Options::getMetadataWarmupManifestPath() const
+{
+    return get<boost::filesystem::path>(
+        {"metadata-warmup-manifest", "metadata_warmup_manifest"});
+}
+
+bool Options::isMetadataWarmupLocationsEnabled() const
+{
+    return get<bool>({"metadata-warmup-locations", "metadata_warmup_locations"})
+        .get_value_or(false);
+}
+
+std::chrono::seconds Options::getHelperParamsRefreshInterval() const
+{
+    return std::chrono::seconds{
+        get<unsigned int>({"helper-params-refresh-interval",
+                              "helper_params_refresh_interval"})
+            .get_value_or(0)};
+}
+
 unsigned int Options::getBufferSchedulerThreadCount() const
 {
     return get<unsigned int>(
@@ -973,6 +1223,95 @@ unsigned int Options::getReaddirPrefetchSize() const
         .get_value_or(DEFAULT_READDIR_PREFETCH_SIZE);
 }
 
+unsigned int Options::getReaddirPrefetchFanout() const
+{
+    return get<unsigned int>(
+        {"readdir-prefetch-fanout", "readdir_prefetch_fanout"})
+        .get_value_or(DEFAULT_READDIR_PREFETCH_FANOUT);
+}
+
+unsigned int Options::getWriteExtentBatchSize() const
+{
+    return get<unsigned int>(
+        {"write-extent-batch-size", "write_extent_batch_size"})
+        .get_value_or(DEFAULT_WRITE_EXTENT_BATCH_SIZE);
+}
+
+unsigned int Options::getMaxAsyncReleases() const
+{
+    return get<unsigned int>({"max-async-releases", "max_async_releases"})
+        .get_value_or(DEFAULT_MAX_ASYNC_RELEASES);
+}
+
+unsigned int Options::getHelperHandlePoolSize() const
+{
+    return get<unsigned int>(
+        {"helper-handle-pool-size", "helper_handle_pool_size"})
+        .get_value_or(DEFAULT_HELPER_HANDLE_POOL_SIZE);
+}
+
+unsigned int Options::getStorageCircuitBreakerThreshold() const
+{
+    return get<unsigned int>({"storage-circuit-breaker-threshold",
+                                 "storage_circuit_breaker_threshold"})
+        .get_value_or(DEFAULT_STORAGE_CIRCUIT_BREAKER_THRESHOLD);
+}
+
+double Options::getIOPathProbeRatio() const
+{
+    return get<double>({"io-path-probe-ratio", "io_path_probe_ratio"})
+        .get_value_or(DEFAULT_IO_PATH_PROBE_RATIO);
+}
+
+bool Options::isFsyncOnReleaseEnabled() const
+{
+    return !get<bool>({"no-fsync-on-release", "no_fsync_on_release"})
+                .get_value_or(false);
+}
+
+boost::optional<boost::filesystem::path> Options::getWriteBackDirPath() const
+{
+    return get<boost::filesystem::path>({"write-back-dir", "write_back_dir"});
+}
+
+std::size_t Options::getWriteBackFileDirtyLimit() const
+{
+    return get<std::size_t>(
+        {"write-back-file-dirty-limit", "write_back_file_dirty_limit"})
+        .get_value_or(DEFAULT_WRITE_BACK_FILE_DIRTY_LIMIT);
+}
+
+std::size_t Options::getWriteBackDirtyLimit() const
+{
+    return get<std::size_t>(
+        {"write-back-dirty-limit", "write_back_dirty_limit"})
+        .get_value_or(DEFAULT_WRITE_BACK_DIRTY_LIMIT);
+}
+
+std::string Options::getWriteBackDurability() const
+{
+    return get<std::string>({"write-back-durability", "write_back_durability"})
+        .get_value_or(DEFAULT_WRITE_BACK_DURABILITY);
+}
+
+bool Options::areDirectorySubscriptionsEnabled() const
+{
+    return get<bool>({"directory-subscriptions", "directory_subscriptions"})
+        .get_value_or(false);
+}
+
+bool Options::areDeterministicInodesEnabled() const
+{
+    return get<bool>({"deterministic-inodes", "deterministic_inodes"})
+        .get_value_or(false);
+}
+
+bool Options::isMetadataCacheClockEnabled() const
+{
+    return get<bool>({"metadata-cache-clock", "metadata_cache_clock"})
+        .get_value_or(false);
+}
+
 boost::optional<std::pair<std::string, std::string>>
 Options::getOnModifyTag() const
 {
@@ -53,6 +53,17 @@ static constexpr auto DEFAULT_PREFETCH_CLUSTER_WINDOW_SIZE = 20971520;
 static constexpr auto DEFAULT_PREFETCH_CLUSTER_BLOCK_THRESHOLD = 5;
 static constexpr auto DEFAULT_METADATA_CACHE_SIZE = 20'000;
 static constexpr auto DEFAULT_READDIR_PREFETCH_SIZE = 2500;
+static constexpr auto DEFAULT_READDIR_PREFETCH_FANOUT = 4;
+static constexpr auto DEFAULT_WRITE_EXTENT_BATCH_SIZE = 16 * 1024 * 1024;
+static constexpr auto DEFAULT_MAX_ASYNC_RELEASES = 0;
+static constexpr auto DEFAULT_HELPER_HANDLE_POOL_SIZE = 0;
+static constexpr auto DEFAULT_STORAGE_CIRCUIT_BREAKER_THRESHOLD = 0;
+static constexpr double DEFAULT_IO_PATH_PROBE_RATIO = 0.0;
+static constexpr std::size_t DEFAULT_WRITE_BACK_FILE_DIRTY_LIMIT =
+    64 * 1024 * 1024;
+static constexpr std::size_t DEFAULT_WRITE_BACK_DIRTY_LIMIT =
+    1024 * 1024 * 1024;
+static constexpr auto DEFAULT_WRITE_BACK_DURABILITY = "close";
 static constexpr auto DEFAULT_PROVIDER_TIMEOUT = 2 * 60;
 static constexpr auto DEFAULT_MONITORING_PERIOD_SECONDS = 30;
 }
@@ -185,6 +196,37 @@ public:
      */
     bool isDirectIOForced() const;
 
+    /*
+     * @return true if 'detect-storages-on-mount' option has been provided,
+     * otherwise false.
+     */
+    bool isStorageDetectionOnMountEnabled() const;
+
+    /*
+     * @return Path of the file storing detected storage access types, if
+     * provided.
+     */
+    boost::optional<boost::filesystem::path>
+    getStorageAccessStateFilePath() const;
+
+    /*
+     * @return Interval of proactive helper parameters refresh, 0 if disabled.
+     */
+    std::chrono::seconds getHelperParamsRefreshInterval() const;
+
+    /*
+     * @return Path of the file listing paths resolved after mounting, if
+     * provided.
+     */
+    boost::optional<boost::filesystem::path>
+    getMetadataWarmupManifestPath() const;
+
+    /*
+     * @return true if 'metadata-warmup-locations' option has been provided,
+     * otherwise false.
+     */
+    bool isMetadataWarmupLocationsEnabled() const;
+
     /*
      * @return Number of parallel buffer scheduler threads.
      */
@@ -332,6 +374,86 @@ public:
      */
     unsigned int getReaddirPrefetchSize() const;
 
+    /*
+     * @return Maximum number of readdir prefetch requests issued in parallel.
+     */
+    unsigned int getReaddirPrefetchFanout() const;
+
+    /*
+     * @return Size in bytes of write extent accumulated per file handle before
+     * it is published to file location and events stream.
+     */
+    unsigned int getWriteExtentBatchSize() const;
+
+    /*
+     * @return Maximum number of file releases completed in background.
+     */
+    unsigned int getMaxAsyncReleases() const;
+
+    /*
+     * @return Maximum number of storage helper handles kept open after file
+     * release for reuse.
+     */
+    unsigned int getHelperHandlePoolSize() const;
+
+    /*
+     * @return Number of consecutive failures of a storage after which its
+     * circuit breaker opens.
+     */
+    unsigned int getStorageCircuitBreakerThreshold() const;
+
+    /*
+     * @return Fraction of storage operations performed through the
+     * alternative of direct and proxy IO, to compare their performance.
+     */
+    double getIOPathProbeRatio() const;
+
+    /*
+     * @return true if provider fsync should be performed on file release.
+     */
+    bool isFsyncOnReleaseEnabled() const;
+
+    /*
+     * @return Path to the directory for local write-back journals, if
+     * write-back mode is enabled.
+     */
+    boost::optional<boost::filesystem::path> getWriteBackDirPath() const;
+
+    /*
+     * @return Maximum number of bytes not yet uploaded to the storage in
+     * a single file handle in write-back mode.
+     */
+    std::size_t getWriteBackFileDirtyLimit() const;
+
+    /*
+     * @return Maximum number of bytes not yet uploaded to the storage in
+     * all file handles in write-back mode.
+     */
+    std::size_t getWriteBackDirtyLimit() const;
+
+    /*
+     * @return Operation after which data written in write-back mode is
+     * uploaded to the storage (close or fsync).
+     */
+    std::string getWriteBackDurability() const;
+
+    /*
+     * @return Whether cached files should be subscribed for changes through
+     * their parent directories.
+     */
+    bool areDirectorySubscriptionsEnabled() const;
+
+    /*
+     * @return Whether inode numbers should be derived from file UUIDs.
+     */
+    bool areDeterministicInodesEnabled() const;
+
+    /*
+     * @return Whether metadata cache should use CLOCK eviction instead of
+     * exact LRU.
+     */
+    bool isMetadataCacheClockEnabled() const;
+
     /*
      * @return Get xattr on-modify tag.
      */
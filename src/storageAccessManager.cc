@@ -23,19 +23,60 @@
 #include <mntent.h>
 #endif
 
+#include <algorithm>
 #include <cerrno>
 #include <random>
+#include <set>
 #include <vector>
 
 namespace one {
 namespace client {
 
 namespace {
+struct MountPoint {
+    boost::filesystem::path path;
+    std::string type;
+};
+
+// Types of filesystems on which storages are usually exported to clients
+const std::set<std::string> NETWORK_FILESYSTEM_TYPES{"nfs", "nfs4", "lustre",
+    "gpfs", "ceph", "beegfs", "glusterfs", "cifs", "smbfs", "panfs"};
+
+/**
+ * Orders mountpoints so that the ones most likely to contain the storage are
+ * probed first - the ones matching the mountpoint used by the provider and
+ * the network filesystems.
+ */
+void rankMountPoints(std::vector<MountPoint> &mountPoints,
+    const std::unordered_map<folly::fbstring, folly::fbstring> &helperArgs)
+{
+    boost::filesystem::path providerMountPoint;
+    auto it = helperArgs.find(helpers::POSIX_HELPER_MOUNT_POINT_ARG);
+    if (it != helperArgs.end())
+        providerMountPoint = it->second.toStdString();
+
+    auto score = [&](const MountPoint &mountPoint) {
+        int result = 0;
+        if (!providerMountPoint.empty() &&
+            (mountPoint.path == providerMountPoint ||
+                mountPoint.path.filename() == providerMountPoint.filename()))
+            result += 2;
+        if (NETWORK_FILESYSTEM_TYPES.count(mountPoint.type) > 0)
+            result += 1;
+        return result;
+    };
+
+    std::stable_sort(mountPoints.begin(), mountPoints.end(),
+        [&](const MountPoint &a, const MountPoint &b) {
+            return score(a) > score(b);
+        });
+}
+
 #ifdef __APPLE__
 
-std::vector<boost::filesystem::path> getMountPoints()
+std::vector<MountPoint> getMountPoints()
 {
-    std::vector<boost::filesystem::path> mountPoints;
+    std::vector<MountPoint> mountPoints;
 
     int mounted_filesystem_count = getfsstat(NULL, 0, MNT_NOWAIT);
     if (mounted_filesystem_count <= 0) {
@@ -64,7 +105,7 @@ std::vector<boost::filesystem::path> getMountPoints()
             path.compare(0, strlen("/dev"), "/dev") != 0 &&
             path.compare(0, strlen("/sys"), "/sys") != 0 &&
             path.compare(0, strlen("/etc"), "/etc") != 0 && path != "/") {
-            mountPoints.push_back(stat.f_mntonname);
+            mountPoints.push_back({stat.f_mntonname, type});
         }
     }
 
@@ -73,9 +114,9 @@ std::vector<boost::filesystem::path> getMountPoints()
 
 #else
 
-std::vector<boost::filesystem::path> getMountPoints()
+std::vector<MountPoint> getMountPoints()
 {
-    std::vector<boost::filesystem::path> mountPoints;
+    std::vector<MountPoint> mountPoints;
 
     FILE *file = setmntent("/proc/mounts", "r");
     if (file == nullptr) {
@@ -92,7 +133,7 @@ std::vector<boost::filesystem::path> getMountPoints()
             path.compare(0, strlen("/dev"), "/dev") != 0 &&
             path.compare(0, strlen("/sys"), "/sys") != 0 &&
             path.compare(0, strlen("/etc"), "/etc") != 0 && path != "/") {
-            mountPoints.emplace_back(ent->mnt_dir);
+            mountPoints.push_back({ent->mnt_dir, type});
         }
     }
 
@@ -121,6 +162,7 @@ StorageAccessManager::verifyStorageTestFile(const folly::fbstring &storageId,
 
     if (helperParams.name() == helpers::POSIX_HELPER_NAME) {
         std::vector<boost::filesystem::path> mountPoints;
+        auto knownMountPoint = mountPoint(storageId);
 
         // Check, if the user has provided a mountPoint override for this
         // storage, otherwise list all local mountpoints
@@ -134,8 +176,10 @@ StorageAccessManager::verifyStorageTestFile(const folly::fbstring &storageId,
             mountPoints.emplace_back(
                 helperParams.args().at("testMountPoint").toStdString());
         }
-        else {
-            mountPoints = getMountPoints();
+        // Start with the mountpoint under which the storage has been
+        // located before, so that other mounts are not touched at all
+        else if (knownMountPoint) {
+            mountPoints.emplace_back(*knownMountPoint);
         }
 
         for (const auto &mountPoint : mountPoints) {
@@ -150,9 +194,25 @@ StorageAccessManager::verifyStorageTestFile(const folly::fbstring &storageId,
             if (verifyStorageTestFile(storageId, helper, testFile)) {
                 LOG_DBG(1) << "Storage " << storageId
                            << " successfuly located under " << mountPoint;
+                setMountPoint(storageId, mountPoint);
                 return helper;
             }
         }
+
+        if (overrideParams.find("mountPoint") == overrideParams.cend() &&
+            helperParams.args().find("testMountPoint") ==
+                helperParams.args().cend()) {
+            auto candidates = getMountPoints();
+            rankMountPoints(candidates, helperParams.args());
+
+            std::vector<boost::filesystem::path> candidatePaths;
+            for (auto &candidate : candidates) {
+                if (!knownMountPoint || candidate.path != *knownMountPoint)
+                    candidatePaths.emplace_back(std::move(candidate.path));
+            }
+
+            return probeMountPoints(storageId, candidatePaths, testFile);
+        }
     }
     else if (helperParams.name() == helpers::NULL_DEVICE_HELPER_NAME) {
         return m_helperFactory.getStorageHelper(helperParams.name(),
@@ -169,6 +229,81 @@ StorageAccessManager::verifyStorageTestFile(const folly::fbstring &storageId,
     return {};
 }
 
+std::shared_ptr<helpers::StorageHelper> StorageAccessManager::probeMountPoints(
+    const folly::fbstring &storageId,
+    const std::vector<boost::filesystem::path> &mountPoints,
+    const messages::fuse::StorageTestFile &testFile)
+{
+    if (mountPoints.empty())
+        return {};
+
+    LOG_DBG(1) << "Probing " << mountPoints.size()
+               << " mountpoints in parallel for storage " << storageId;
+
+    auto found = std::make_shared<std::atomic<bool>>(false);
+
+    std::vector<std::shared_ptr<helpers::StorageHelper>> candidateHelpers;
+    std::vector<folly::Future<folly::Unit>> probes;
+    for (const auto &mountPoint : mountPoints) {
+        auto helper = m_helperFactory.getStorageHelper(
+            helpers::POSIX_HELPER_NAME,
+            {{helpers::POSIX_HELPER_MOUNT_POINT_ARG, mountPoint.string()}},
+            m_options.isIOBuffered());
+
+        probes.emplace_back(probeStorageTestFile(helper, testFile, found));
+        candidateHelpers.emplace_back(std::move(helper));
+    }
+
+    // The first matching mountpoint wins, the probes which are still in
+    // progress stop before reading the test file
+    auto winner =
+        folly::collectAnyWithoutException(probes.begin(), probes.end())
+            .getTry();
+
+    if (winner.hasException()) {
+        LOG_DBG(1) << "Storage " << storageId
+                   << " not found under any of local mountpoints";
+        return {};
+    }
+
+    const auto &mountPoint = mountPoints[winner.value().first];
+    LOG_DBG(1) << "Storage " << storageId << " successfuly located under "
+               << mountPoint;
+
+    setMountPoint(storageId, mountPoint);
+    return candidateHelpers[winner.value().first];
+}
+
+folly::Future<folly::Unit> StorageAccessManager::probeStorageTestFile(
+    std::shared_ptr<helpers::StorageHelper> helper,
+    const messages::fuse::StorageTestFile &testFile,
+    std::shared_ptr<std::atomic<bool>> found)
+{
+    const auto size = testFile.fileContent().size();
+    const auto timeout = helper->timeout();
+
+    return helper->open(testFile.fileId(), O_RDONLY, {})
+        .then([size, found](helpers::FileHandlePtr handle) {
+            if (*found)
+                throw std::system_error{
+                    std::make_error_code(std::errc::operation_canceled)};
+
+            return handle->read(0, size);
+        })
+        .then([ content = testFile.fileContent(), found ](
+            folly::IOBufQueue && buf) {
+            std::string actual;
+            buf.appendToString(actual);
+
+            if (actual != content)
+                throw std::system_error{
+                    std::make_error_code(std::errc::no_such_file_or_directory)};
+
+            *found = true;
+        })
+        .within(timeout);
+}
+
 bool StorageAccessManager::verifyStorageTestFile(
     const folly::fbstring &storageId,
     std::shared_ptr<helpers::StorageHelper> helper,
@@ -213,6 +348,25 @@ bool StorageAccessManager::verifyStorageTestFile(
     return false;
 }
 
+folly::Optional<boost::filesystem::path> StorageAccessManager::mountPoint(
+    const folly::fbstring &storageId)
+{
+    std::lock_guard<std::mutex> guard{m_mountPointsMutex};
+
+    auto it = m_mountPoints.find(storageId);
+    if (it == m_mountPoints.end())
+        return {};
+
+    return it->second;
+}
+
+void StorageAccessManager::setMountPoint(
+    const folly::fbstring &storageId, boost::filesystem::path mountPoint)
+{
+    std::lock_guard<std::mutex> guard{m_mountPointsMutex};
+    m_mountPoints[storageId] = std::move(mountPoint);
+}
+
 folly::fbstring StorageAccessManager::modifyStorageTestFile(
     const folly::fbstring &storageId,
     std::shared_ptr<helpers::StorageHelper> helper,
@@ -14,7 +14,12 @@
 
 #include <boost/filesystem.hpp>
 #include <folly/FBString.h>
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace one {
@@ -65,7 +70,35 @@ public:
         std::shared_ptr<helpers::StorageHelper> helper,
         const messages::fuse::StorageTestFile &testFile);
 
+    /**
+     * Returns the local mountpoint under which a POSIX storage has been
+     * located.
+     * @param storageId Id of the storage
+     * @return The mountpoint, if known.
+     */
+    folly::Optional<boost::filesystem::path> mountPoint(
+        const folly::fbstring &storageId);
+
+    /**
+     * Sets the local mountpoint, which will be verified first when locating
+     * a POSIX storage, e.g. the one found during previous mount.
+     * @param storageId Id of the storage
+     * @param mountPoint The mountpoint.
+     */
+    void setMountPoint(
+        const folly::fbstring &storageId, boost::filesystem::path mountPoint);
+
 private:
+    std::shared_ptr<helpers::StorageHelper> probeMountPoints(
+        const folly::fbstring &storageId,
+        const std::vector<boost::filesystem::path> &mountPoints,
+        const messages::fuse::StorageTestFile &testFile);
+
+    folly::Future<folly::Unit> probeStorageTestFile(
+        std::shared_ptr<helpers::StorageHelper> helper,
+        const messages::fuse::StorageTestFile &testFile,
+        std::shared_ptr<std::atomic<bool>> found);
+
     bool verifyStorageTestFile(const folly::fbstring &storageId,
         std::shared_ptr<helpers::StorageHelper> helper,
         const messages::fuse::StorageTestFile &testFile);
@@ -74,6 +107,10 @@ private:
 
     // Reference to command line options provided to Oneclient
     const options::Options &m_options;
+
+    // Mountpoints under which POSIX storages have been located
+    std::unordered_map<folly::fbstring, boost::filesystem::path> m_mountPoints;
+    std::mutex m_mountPointsMutex;
 };
 
 } // namespace client
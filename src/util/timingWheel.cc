@@ -0,0 +1,145 @@
+/**
+ * @file timingWheel.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "timingWheel.h"
+
+#include "helpers/logging.h"
+
+#include <folly/ThreadName.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace one {
+namespace client {
+namespace util {
+
+TimingWheel::TimingWheel(std::chrono::milliseconds tick, std::size_t slots)
+    : m_tick{tick}
+    , m_slots(slots)
+{
+    assert(tick.count() > 0);
+    assert(slots > 0);
+
+    m_thread = std::thread{[this] {
+        folly::setThreadName("TimingWheel");
+        run();
+    }};
+}
+
+TimingWheel::~TimingWheel()
+{
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_stopped = true;
+    }
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+std::function<void()> TimingWheel::schedule(
+    std::chrono::milliseconds after, std::function<void()> task)
+{
+    const auto slotsCount = m_slots.size();
+    const auto ticks = static_cast<std::size_t>(std::max<std::int64_t>(
+        1, (after.count() + m_tick.count() - 1) / m_tick.count()));
+
+    auto timer =
+        std::make_shared<Timer>(std::move(task), (ticks - 1) / slotsCount);
+
+    bool wasEmpty = false;
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_slots[(m_cursor + ticks) % slotsCount].emplace_back(timer);
+        wasEmpty = m_size++ == 0;
+    }
+
+    if (wasEmpty)
+        m_wakeUp.notify_one();
+
+    return [weakTimer = std::weak_ptr<Timer>{timer}] {
+        if (auto timer = weakTimer.lock())
+            timer->cancelled = true;
+    };
+}
+
+std::vector<std::shared_ptr<TimingWheel::Timer>> TimingWheel::tick()
+{
+    std::vector<std::shared_ptr<Timer>> expired;
+
+    m_cursor = (m_cursor + 1) % m_slots.size();
+    auto &slot = m_slots[m_cursor];
+
+    std::size_t i = 0;
+    while (i < slot.size()) {
+        auto &timer = slot[i];
+        if (!timer->cancelled && timer->rounds > 0) {
+            --timer->rounds;
+            ++i;
+            continue;
+        }
+
+        if (!timer->cancelled)
+            expired.emplace_back(std::move(timer));
+
+        // Order of timers within a slot does not matter, so the removed one
+        // is replaced with the last one, unless it is the last one itself
+        if (i + 1 < slot.size())
+            slot[i] = std::move(slot.back());
+        slot.pop_back();
+        --m_size;
+    }
+
+    return expired;
+}
+
+void TimingWheel::run()
+{
+    auto nextTick = std::chrono::steady_clock::now() + m_tick;
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (!m_stopped) {
+        if (m_size == 0) {
+            m_wakeUp.wait(lock, [this] { return m_stopped || m_size > 0; });
+            nextTick = std::chrono::steady_clock::now() + m_tick;
+            continue;
+        }
+
+        if (m_wakeUp.wait_until(lock, nextTick, [this] { return m_stopped; }))
+            break;
+
+        // Catch up on ticks missed while running tasks
+        std::vector<std::shared_ptr<Timer>> expired;
+        while (nextTick <= std::chrono::steady_clock::now()) {
+            auto ticked = tick();
+            std::move(ticked.begin(), ticked.end(),
+                std::back_inserter(expired));
+            nextTick += m_tick;
+        }
+
+        lock.unlock();
+        for (auto &timer : expired) {
+            if (timer->cancelled)
+                continue;
+
+            try {
+                timer->task();
+            }
+            catch (const std::exception &e) {
+                LOG(ERROR) << "Timing wheel task failed: " << e.what();
+            }
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
+
+} // namespace util
+} // namespace client
+} // namespace one
@@ -0,0 +1,102 @@
+/**
+ * @file timingWheel.h
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace util {
+
+constexpr std::chrono::milliseconds DEFAULT_TIMING_WHEEL_TICK{10};
+constexpr std::size_t DEFAULT_TIMING_WHEEL_SLOTS{512};
+
+/**
+ * @c TimingWheel is a hashed timing wheel, which runs scheduled tasks with
+ * tick resolution from a single tick thread. Scheduling and cancelling a task
+ * take constant time, regardless of the number of armed timers. Timers due
+ * after more than one revolution of the wheel keep the number of remaining
+ * revolutions in their slot. The tick thread sleeps while no timers are armed.
+ *
+ * Tasks are run in the tick thread, so they should only post longer work to
+ * other executors.
+ */
+class TimingWheel {
+public:
+    /**
+     * Constructor.
+     * Starts the tick thread.
+     * @param tick Duration of a single tick, i.e. the timers resolution.
+     * @param slots Number of slots in the wheel.
+     */
+    TimingWheel(std::chrono::milliseconds tick = DEFAULT_TIMING_WHEEL_TICK,
+        std::size_t slots = DEFAULT_TIMING_WHEEL_SLOTS);
+
+    /**
+     * Destructor.
+     * Stops the tick thread, dropping armed timers.
+     */
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator=(const TimingWheel &) = delete;
+
+    /**
+     * Schedules a task to be run after a delay, rounded up to a full tick.
+     * @param after Delay after which the task is run.
+     * @param task The task to run.
+     * @returns A function cancelling the task, which can be safely called
+     * after the task has been run.
+     */
+    std::function<void()> schedule(
+        std::chrono::milliseconds after, std::function<void()> task);
+
+    /**
+     * @returns Number of armed timers, including cancelled timers not yet
+     * removed from the wheel.
+     */
+    std::size_t size() const { return m_size; }
+
+private:
+    struct Timer {
+        Timer(std::function<void()> task_, std::size_t rounds_)
+            : task{std::move(task_)}
+            , rounds{rounds_}
+        {
+        }
+
+        std::function<void()> task;
+        std::size_t rounds;
+        std::atomic<bool> cancelled{false};
+    };
+
+    void run();
+    std::vector<std::shared_ptr<Timer>> tick();
+
+    const std::chrono::milliseconds m_tick;
+    std::vector<std::vector<std::shared_ptr<Timer>>> m_slots;
+    std::size_t m_cursor = 0;
+    std::atomic<std::size_t> m_size{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stopped = false;
+    std::thread m_thread;
+};
+
+} // namespace util
+} // namespace client
+} // namespace one
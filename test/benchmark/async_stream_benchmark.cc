@@ -0,0 +1,163 @@
+/**
+ * @file async_stream_benchmark.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "events/events.h"
+
+#include <boost/filesystem.hpp>
+#include <folly/Benchmark.h>
+#include <folly/synchronization/Baton.h>
+
+#include <iostream>
+#include <iterator>
+
+using namespace one::client::events;
+
+constexpr auto streamsCount = 8;
+
+namespace {
+/**
+ * Stream posting a baton on each processed event.
+ */
+class BatonStream : public Stream {
+public:
+    void process(EventPtr<> event) override
+    {
+        folly::doNotOptimizeAway(event);
+        baton.post();
+    }
+
+    void flush() override {}
+
+    void flush(const AggregationKey & /*aggregationKey*/) override {}
+
+    folly::Baton<> baton;
+};
+
+/**
+ * Event stream wrapper processing events in a dedicated thread, the way
+ * @c AsyncStream used to work before streams shared an executor.
+ */
+class DedicatedThreadStream : public Stream {
+public:
+    DedicatedThreadStream(StreamPtr stream)
+        : m_ioService{1}
+        , m_idleWork{asio::make_work_guard(m_ioService)}
+        , m_worker{[this] { m_ioService.run(); }}
+        , m_stream{std::move(stream)}
+    {
+    }
+
+    ~DedicatedThreadStream()
+    {
+        m_ioService.stop();
+        m_worker.join();
+    }
+
+    void process(EventPtr<> event) override
+    {
+        asio::post(m_ioService, [ this, event = std::move(event) ]() mutable {
+            m_stream->process(std::move(event));
+        });
+    }
+
+    void flush() override
+    {
+        asio::post(m_ioService, [this] { m_stream->flush(); });
+    }
+
+    void flush(const AggregationKey &aggregationKey) override
+    {
+        asio::post(m_ioService,
+            [this, aggregationKey] { m_stream->flush(aggregationKey); });
+    }
+
+private:
+    asio::io_service m_ioService;
+    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork;
+    std::thread m_worker;
+    StreamPtr m_stream;
+};
+
+/**
+ * @returns Number of threads of the current process.
+ */
+std::size_t processThreadCount()
+{
+    return std::distance(
+        boost::filesystem::directory_iterator{"/proc/self/task"},
+        boost::filesystem::directory_iterator{});
+}
+
+/**
+ * @returns Number of threads started by creating @c streamsCount streams.
+ */
+template <class WrapperStream> std::size_t measureThreadsUsed()
+{
+    const auto threadsBefore = processThreadCount();
+
+    std::vector<std::unique_ptr<Stream>> streams;
+    for (int i = 0; i < streamsCount; ++i)
+        streams.emplace_back(
+            std::make_unique<WrapperStream>(std::make_unique<BatonStream>()));
+
+    return processThreadCount() - threadsBefore;
+}
+
+template <class WrapperStream> void benchmarkHopLatency(std::size_t iters)
+{
+    std::vector<BatonStream *> targets;
+    std::vector<std::unique_ptr<Stream>> streams;
+    BENCHMARK_SUSPEND
+    {
+        for (int i = 0; i < streamsCount; ++i) {
+            auto target = std::make_unique<BatonStream>();
+            targets.emplace_back(target.get());
+            streams.emplace_back(
+                std::make_unique<WrapperStream>(std::move(target)));
+        }
+    }
+
+    for (std::size_t i = 0; i < iters; ++i) {
+        const auto n = i % streamsCount;
+        streams[n]->process(std::make_unique<FileRead>("fileUuid", 0, 1));
+        targets[n]->baton.wait();
+        targets[n]->baton.reset();
+    }
+
+    BENCHMARK_SUSPEND { streams.clear(); }
+}
+} // namespace
+
+/**
+ * Measures the latency of passing an event to a stream processing it in
+ * a dedicated thread, one thread per stream.
+ */
+BENCHMARK(benchmarkDedicatedThreadHopLatency, iters)
+{
+    benchmarkHopLatency<DedicatedThreadStream>(iters);
+}
+
+/**
+ * Measures the latency of passing an event to a stream processing it in
+ * a strand of the executor shared by all streams.
+ */
+BENCHMARK_RELATIVE(benchmarkSharedExecutorHopLatency, iters)
+{
+    benchmarkHopLatency<AsyncStream>(iters);
+}
+
+int main()
+{
+    std::cout << "Threads used by " << streamsCount
+              << " streams: dedicated threads: "
+              << measureThreadsUsed<DedicatedThreadStream>()
+              << ", shared executor: " << measureThreadsUsed<AsyncStream>()
+              << std::endl;
+
+    folly::runBenchmarks();
+}
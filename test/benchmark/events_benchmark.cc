@@ -0,0 +1,155 @@
+/**
+ * @file events_benchmark.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/forceProxyIOCache.h"
+#include "cache/helpersCache.h"
+#include "communication/communicator.h"
+#include "events/events.h"
+#include "fslogic/fuseFileHandle.h"
+#include "options/options.h"
+#include "scheduler.h"
+
+#include <boost/icl/discrete_interval.hpp>
+#include <folly/Benchmark.h>
+
+#include <fcntl.h>
+
+using namespace one::client;
+using namespace one::client::events;
+
+constexpr auto blockSize = 4 * 1024;                   // 4KB
+constexpr auto readExtentBatchSize = 16 * 1024 * 1024; // 16MB
+
+namespace {
+std::unique_ptr<TypedStream<FileRead>> makeFileReadStream()
+{
+    return std::make_unique<TypedStream<FileRead>>(
+        std::make_unique<KeyAggregator<FileRead>>(),
+        std::make_unique<CounterEmitter<FileRead>>(1000),
+        std::make_unique<LocalHandler<FileRead>>(
+            [](Events<FileRead> events) {
+                folly::doNotOptimizeAway(events);
+            }));
+}
+
+/**
+ * File handle along with the caches it depends on.
+ */
+struct FileHandleEnvironment {
+    options::Options options;
+    one::Scheduler scheduler{0};
+    one::communication::Communicator communicator{
+        1, 1, "127.0.0.1", 80, false};
+    cache::HelpersCache helpersCache{communicator, scheduler, options};
+    cache::ForceProxyIOCache forceProxyIOCache;
+    fslogic::FuseFileHandle handle{O_RDONLY, "handleId", nullptr,
+        helpersCache, forceProxyIOCache, std::chrono::seconds{10}};
+};
+
+void publishRead(
+    TypedStream<FileRead> &stream, fslogic::FuseFileHandle::PendingRead read)
+{
+    stream.process(std::make_unique<FileRead>(
+        read.uuid.toStdString(), read.range, read.size, read.counter));
+}
+
+/**
+ * Coalesces reads in a file handle the way @c FsLogic::read does and
+ * processes the resulting events in a stream.
+ */
+void readThroughHandle(std::size_t iters,
+    const std::function<off_t(std::size_t)> &readOffset)
+{
+    std::unique_ptr<TypedStream<FileRead>> stream;
+    std::unique_ptr<FileHandleEnvironment> env;
+    BENCHMARK_SUSPEND
+    {
+        stream = makeFileReadStream();
+        env = std::make_unique<FileHandleEnvironment>();
+    }
+
+    const folly::fbstring uuid{"fileUuid"};
+    for (std::size_t i = 0; i < iters; ++i) {
+        auto previousRead = env->handle.addPendingRead(uuid,
+            boost::icl::discrete_interval<off_t>::right_open(
+                readOffset(i), readOffset(i) + blockSize));
+
+        if (previousRead)
+            publishRead(*stream, std::move(*previousRead));
+
+        if (env->handle.pendingReadSize() >= readExtentBatchSize)
+            publishRead(*stream, std::move(*env->handle.takePendingRead()));
+    }
+
+    auto pendingRead = env->handle.takePendingRead();
+    if (pendingRead)
+        publishRead(*stream, std::move(*pendingRead));
+
+    stream->flush();
+
+    BENCHMARK_SUSPEND { env.reset(); }
+}
+} // namespace
+
+/**
+ * Emits a separate event for each sequential read of a file.
+ */
+BENCHMARK(benchmarkFileReadEventPerRead, iters)
+{
+    std::unique_ptr<TypedStream<FileRead>> stream;
+    BENCHMARK_SUSPEND { stream = makeFileReadStream(); }
+
+    const std::string uuid{"fileUuid"};
+    for (std::size_t i = 0; i < iters; ++i)
+        stream->process(
+            std::make_unique<FileRead>(uuid, i * blockSize, blockSize));
+
+    stream->flush();
+}
+
+/**
+ * Coalesces sequential reads of a file in a file handle, emitting a single
+ * event per read extent.
+ */
+BENCHMARK_RELATIVE(benchmarkFileReadEventPerExtent, iters)
+{
+    readThroughHandle(iters, [](std::size_t i) { return i * blockSize; });
+}
+
+/**
+ * Coalesces repeated reads of a single block of a file in a file handle.
+ */
+BENCHMARK_RELATIVE(benchmarkFileReadEventPerExtentSameBlock, iters)
+{
+    readThroughHandle(iters, [](std::size_t) { return 0; });
+}
+
+BENCHMARK_DRAW_LINE();
+
+/**
+ * Emits a separate event for each read of interleaved files.
+ */
+BENCHMARK(benchmarkFileReadEventPerReadManyFiles, iters)
+{
+    std::unique_ptr<TypedStream<FileRead>> stream;
+    std::vector<std::string> uuids;
+    BENCHMARK_SUSPEND
+    {
+        stream = makeFileReadStream();
+        for (int i = 0; i < 64; ++i)
+            uuids.emplace_back("fileUuid" + std::to_string(i));
+    }
+
+    for (std::size_t i = 0; i < iters; ++i)
+        stream->process(std::make_unique<FileRead>(uuids[i % uuids.size()],
+            (i / uuids.size()) * blockSize, blockSize));
+
+    stream->flush();
+}
+
+int main() { folly::runBenchmarks(); }
@@ -0,0 +1,102 @@
+/**
+ * @file inode_cache_benchmark.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/inodeCache.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace one::client::cache;
+
+constexpr auto entriesCount = 10000000;
+
+namespace {
+folly::fbstring makeUuid(std::size_t i)
+{
+    return "Z3VpZCNmaWxlI2Q5ZjE3ZTFhNmQ3YjQ2ZjUyMTM0YTk5ZmQ3YzY3ZjIz" +
+        folly::to<folly::fbstring>(i);
+}
+
+/**
+ * Creates an inode cache holding entriesCount looked up entries.
+ */
+std::unique_ptr<InodeCache> makeCache(std::vector<fuse_ino_t> &inodes)
+{
+    auto cache = std::make_unique<InodeCache>("rootUuid", 2 * entriesCount);
+    inodes.reserve(entriesCount);
+    for (std::size_t i = 0; i < entriesCount; ++i)
+        inodes.emplace_back(cache->lookup(makeUuid(i)));
+    return cache;
+}
+} // namespace
+
+/**
+ * Looks up new uuids in an inode cache holding 10M entries.
+ */
+BENCHMARK(benchmarkInodeCacheLookupNew, iters)
+{
+    std::unique_ptr<InodeCache> cache;
+    std::vector<fuse_ino_t> inodes;
+    std::vector<folly::fbstring> uuids;
+    BENCHMARK_SUSPEND
+    {
+        cache = makeCache(inodes);
+        for (std::size_t i = 0; i < iters; ++i)
+            uuids.emplace_back(makeUuid(entriesCount + i));
+    }
+
+    for (const auto &uuid : uuids)
+        folly::doNotOptimizeAway(cache->lookup(uuid));
+
+    BENCHMARK_SUSPEND { cache.reset(); }
+}
+
+/**
+ * Translates random inodes to uuids in an inode cache holding 10M entries,
+ * as done on every FUSE operation.
+ */
+BENCHMARK(benchmarkInodeCacheAt, iters)
+{
+    std::unique_ptr<InodeCache> cache;
+    std::vector<fuse_ino_t> inodes;
+    std::mt19937_64 random;
+    BENCHMARK_SUSPEND { cache = makeCache(inodes); }
+
+    for (std::size_t i = 0; i < iters; ++i)
+        folly::doNotOptimizeAway(cache->at(inodes[random() % inodes.size()]));
+
+    BENCHMARK_SUSPEND { cache.reset(); }
+}
+
+/**
+ * Forgets entries of a full inode cache holding 10M entries, so that each
+ * forget makes the cache prune.
+ */
+BENCHMARK(benchmarkInodeCacheForgetAndPrune, iters)
+{
+    std::unique_ptr<InodeCache> cache;
+    std::vector<fuse_ino_t> inodes;
+    BENCHMARK_SUSPEND
+    {
+        cache = std::make_unique<InodeCache>("rootUuid", entriesCount);
+        inodes.reserve(entriesCount + iters);
+        for (std::size_t i = 0; i < entriesCount + iters; ++i)
+            inodes.emplace_back(cache->lookup(makeUuid(i)));
+    }
+
+    for (std::size_t i = 0; i < iters; ++i)
+        cache->forget(inodes[i], 1);
+
+    BENCHMARK_SUSPEND { cache.reset(); }
+}
+
+int main() { folly::runBenchmarks(); }
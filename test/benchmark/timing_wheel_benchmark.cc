@@ -0,0 +1,77 @@
+/**
+ * @file timing_wheel_benchmark.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "scheduler.h"
+#include "util/timingWheel.h"
+
+#include <folly/Benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace one::client::util;
+using namespace std::literals;
+
+constexpr auto armedTimersCount = 1000000;
+
+namespace {
+template <class Timers>
+void benchmarkScheduleAndCancel(std::size_t iters, Timers &timers)
+{
+    std::vector<std::function<void()>> armed;
+    BENCHMARK_SUSPEND
+    {
+        armed.reserve(armedTimersCount);
+        for (int i = 0; i < armedTimersCount; ++i)
+            armed.emplace_back(
+                timers.schedule(1h + std::chrono::milliseconds{i}, [] {}));
+    }
+
+    // Emulate emitters rescheduling their flush with 1M timers armed
+    for (std::size_t i = 0; i < iters; ++i) {
+        auto cancel = timers.schedule(500ms, [] {});
+        cancel();
+    }
+
+    BENCHMARK_SUSPEND
+    {
+        for (auto &cancel : armed)
+            cancel();
+    }
+}
+} // namespace
+
+/**
+ * Schedules and cancels a timer on the ASIO based scheduler, with 1M timers
+ * already armed.
+ */
+BENCHMARK(benchmarkSchedulerScheduleAndCancel, iters)
+{
+    std::unique_ptr<one::Scheduler> scheduler;
+    BENCHMARK_SUSPEND { scheduler = std::make_unique<one::Scheduler>(1); }
+
+    benchmarkScheduleAndCancel(iters, *scheduler);
+
+    BENCHMARK_SUSPEND { scheduler.reset(); }
+}
+
+/**
+ * Schedules and cancels a timer on the timing wheel, with 1M timers already
+ * armed.
+ */
+BENCHMARK_RELATIVE(benchmarkTimingWheelScheduleAndCancel, iters)
+{
+    std::unique_ptr<TimingWheel> wheel;
+    BENCHMARK_SUSPEND { wheel = std::make_unique<TimingWheel>(); }
+
+    benchmarkScheduleAndCancel(iters, *wheel);
+
+    BENCHMARK_SUSPEND { wheel.reset(); }
+}
+
+int main() { folly::runBenchmarks(); }
@@ -12,6 +12,7 @@
 #include "messages/fuse/fileAttr.h"
 #include "messages/fuse/fileLocation.h"
 #include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include "messages.pb.h"
 
@@ -179,6 +180,8 @@ boost::shared_ptr<ManagerProxy> create(
 
     auto context = std::make_shared<Context>();
     context->setScheduler(std::make_shared<Scheduler>(1));
+    context->setTimingWheel(
+        std::make_shared<one::client::util::TimingWheel>());
     context->setCommunicator(communicator);
     communicator->setScheduler(context->scheduler());
     communicator->connect();
@@ -16,6 +16,7 @@
 #include "messages/configuration.h"
 #include "options/options.h"
 #include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
@@ -312,6 +313,8 @@ boost::shared_ptr<FsLogicProxy> create(std::string ip, int port)
 
     auto context = std::make_shared<Context>();
     context->setScheduler(std::make_shared<Scheduler>(1));
+    context->setTimingWheel(
+        std::make_shared<one::client::util::TimingWheel>());
     context->setCommunicator(communicator);
     const auto globalConfigPath = boost::filesystem::unique_path();
     context->setOptions(std::make_shared<options::Options>());
@@ -1071,6 +1071,24 @@ def test_release_should_send_fsync_message(endpoint, fl, uuid):
     assert client_message.fuse_request.file_request.HasField('fsync')
 
 
+def test_small_file_should_take_five_provider_round_trips(endpoint, fl,
+                                                         uuid):
+    messages_before = endpoint.all_messages_count()
+
+    # getattr, file location and open
+    fh = do_open(endpoint, fl, uuid, size=0, blocks=[(0, 10)])
+    assert 3 == endpoint.all_messages_count() - messages_before
+
+    # written range is published locally and the helper handle is opened
+    # directly on the storage
+    assert 5 == fl.write(uuid, fh, 0, 5)
+    assert 3 == endpoint.all_messages_count() - messages_before
+
+    # fsync and release
+    do_release(endpoint, fl, uuid, fh)
+    assert 5 == endpoint.all_messages_count() - messages_before
+
+
 def test_fslogic_should_handle_processing_status_message(endpoint, fl, uuid):
     getattr_response = prepare_attr_response(uuid, fuse_messages_pb2.DIR)
     rename_response = prepare_rename_response('newUuid')
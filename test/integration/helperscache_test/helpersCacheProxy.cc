@@ -16,6 +16,7 @@
 #include "messages/configuration.h"
 #include "options/options.h"
 #include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -179,6 +180,8 @@ boost::shared_ptr<HelpersCacheProxy> create(
 
     auto context = std::make_shared<Context>();
     context->setScheduler(std::make_shared<Scheduler>(4));
+    context->setTimingWheel(
+        std::make_shared<one::client::util::TimingWheel>());
     context->setCommunicator(communicator);
     const auto globalConfigPath = boost::filesystem::unique_path();
     context->setOptions(std::make_shared<options::Options>());
@@ -0,0 +1,131 @@
+/**
+ * @file helper_handle_pool_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/helperHandlePool.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+
+#include <vector>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client;
+using namespace one::client::cache;
+
+namespace {
+class TestHandle : public helpers::FileHandle {
+public:
+    TestHandle()
+        : helpers::FileHandle{{}, {}}
+    {
+    }
+
+    folly::Future<folly::IOBufQueue> read(
+        const off_t, const std::size_t) override
+    {
+        return folly::makeFuture<folly::IOBufQueue>(
+            std::system_error{std::make_error_code(std::errc::io_error)});
+    }
+
+    folly::Future<std::size_t> write(
+        const off_t, folly::IOBufQueue buf) override
+    {
+        return buf.chainLength();
+    }
+
+    folly::Future<folly::Unit> release() override
+    {
+        return folly::makeFuture();
+    }
+
+    folly::Future<folly::Unit> flush() override { return folly::makeFuture(); }
+
+    folly::Future<folly::Unit> fsync(bool) override
+    {
+        return folly::makeFuture();
+    }
+
+    const helpers::Timeout &timeout() override { return m_timeout; }
+
+private:
+    helpers::Timeout m_timeout{60};
+};
+} // namespace
+
+class HelperHandlePoolTest : public ::testing::Test {
+protected:
+    HelperHandlePoolTest()
+    {
+        pool.onEvict([this](const folly::fbstring &uuid,
+                         helpers::FileHandlePtr /*handle*/) {
+            evicted.emplace_back(uuid.toStdString());
+        });
+    }
+
+    HelperHandlePool pool{2, std::chrono::seconds{10}};
+    std::vector<std::string> evicted;
+};
+
+TEST_F(HelperHandlePoolTest, takeShouldReturnHandleWithMatchingKey)
+{
+    auto handle = std::make_shared<TestHandle>();
+    EXPECT_TRUE(pool.put("uuid1", "s1", "f1", O_RDONLY, handle));
+
+    EXPECT_FALSE(pool.take("s1", "f1", O_RDWR));
+    EXPECT_FALSE(pool.take("s1", "f2", O_RDONLY));
+    EXPECT_EQ(handle, pool.take("s1", "f1", O_RDONLY));
+    EXPECT_FALSE(pool.take("s1", "f1", O_RDONLY));
+    EXPECT_TRUE(evicted.empty());
+}
+
+TEST_F(HelperHandlePoolTest, putShouldEvictLeastRecentlyReleasedHandle)
+{
+    pool.put("uuid1", "s1", "f1", O_RDONLY, std::make_shared<TestHandle>());
+    pool.put("uuid2", "s1", "f2", O_RDONLY, std::make_shared<TestHandle>());
+    pool.put("uuid3", "s1", "f3", O_RDONLY, std::make_shared<TestHandle>());
+
+    EXPECT_EQ(std::vector<std::string>{"uuid1"}, evicted);
+    EXPECT_EQ(2, pool.size());
+    EXPECT_FALSE(pool.take("s1", "f1", O_RDONLY));
+}
+
+TEST_F(HelperHandlePoolTest, invalidateShouldEvictAllHandlesOfFile)
+{
+    pool.put("uuid1", "s1", "f1", O_RDONLY, std::make_shared<TestHandle>());
+    pool.put("uuid1", "s1", "f1", O_RDWR, std::make_shared<TestHandle>());
+
+    pool.invalidate("uuid2");
+    EXPECT_TRUE(pool.contains("uuid1"));
+
+    pool.invalidate("uuid1");
+    EXPECT_FALSE(pool.contains("uuid1"));
+    EXPECT_EQ((std::vector<std::string>{"uuid1", "uuid1"}), evicted);
+    EXPECT_EQ(0, pool.size());
+}
+
+TEST_F(HelperHandlePoolTest, pruneShouldEvictExpiredHandles)
+{
+    HelperHandlePool shortPool{2, std::chrono::seconds{0}};
+    shortPool.put(
+        "uuid1", "s1", "f1", O_RDONLY, std::make_shared<TestHandle>());
+
+    shortPool.prune();
+
+    EXPECT_EQ(0, shortPool.size());
+}
+
+TEST_F(HelperHandlePoolTest, disabledPoolShouldNotAcceptHandles)
+{
+    HelperHandlePool disabledPool{0, std::chrono::seconds{10}};
+
+    EXPECT_FALSE(disabledPool.enabled());
+    EXPECT_FALSE(disabledPool.put(
+        "uuid1", "s1", "f1", O_RDONLY, std::make_shared<TestHandle>()));
+}
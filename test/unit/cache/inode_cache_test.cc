@@ -0,0 +1,135 @@
+/**
+ * @file inode_cache_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/inodeCache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace one::client::cache;
+
+TEST(InodeCacheTest, lookupShouldAssignSequentialInodesByDefault)
+{
+    InodeCache cache{"rootUuid"};
+
+    ASSERT_EQ(FUSE_ROOT_ID + 1, cache.lookup("uuid1"));
+    ASSERT_EQ(FUSE_ROOT_ID + 2, cache.lookup("uuid2"));
+    ASSERT_EQ(FUSE_ROOT_ID + 1, cache.lookup("uuid1"));
+    ASSERT_EQ("uuid2", cache.at(FUSE_ROOT_ID + 2));
+}
+
+TEST(InodeCacheTest, deterministicInodesShouldBeStableAcrossInstances)
+{
+    InodeCache cache1{"rootUuid", DEFAULT_INODE_CACHE_SIZE, true};
+    InodeCache cache2{"rootUuid", DEFAULT_INODE_CACHE_SIZE, true};
+
+    const auto inode1 = cache1.lookup("uuid1");
+    const auto inode2 = cache1.lookup("uuid2");
+
+    ASSERT_NE(inode1, inode2);
+    ASSERT_GT(inode1, FUSE_ROOT_ID);
+    ASSERT_EQ(inode2, cache2.lookup("uuid2"));
+    ASSERT_EQ(inode1, cache2.lookup("uuid1"));
+    ASSERT_EQ("uuid1", cache2.at(inode1));
+}
+
+TEST(InodeCacheTest, deterministicInodeShouldBeStableAfterPrune)
+{
+    InodeCache cache{"rootUuid", 1, true};
+
+    const auto inode = cache.lookup("uuid1");
+    cache.forget(inode, 1);
+    cache.lookup("uuid2");
+
+    ASSERT_THROW(cache.at(inode), std::out_of_range);
+    ASSERT_EQ(inode, cache.lookup("uuid1"));
+}
+
+TEST(InodeCacheTest, generationShouldBeStableAndNonZero)
+{
+    ASSERT_NE(0, InodeCache::generation("uuid1"));
+    ASSERT_NE(0, InodeCache::generation(""));
+    ASSERT_EQ(InodeCache::generation("uuid1"), InodeCache::generation("uuid1"));
+    ASSERT_NE(InodeCache::generation("uuid1"), InodeCache::generation("uuid2"));
+}
+
+TEST(InodeCacheTest, renameShouldKeepInode)
+{
+    InodeCache cache{"rootUuid", DEFAULT_INODE_CACHE_SIZE, true};
+
+    const auto inode = cache.lookup("uuid1");
+    cache.rename("uuid1", "uuid2");
+
+    ASSERT_EQ("uuid2", cache.at(inode));
+    ASSERT_EQ(inode, cache.lookup("uuid2"));
+}
+
+TEST(InodeCacheTest, pruneShouldEvictInBatchesDownToLowWatermark)
+{
+    InodeCache cache{"rootUuid", 64};
+
+    std::vector<fuse_ino_t> inodes;
+    for (int i = 0; i < 80; ++i)
+        inodes.emplace_back(cache.lookup("uuid" + std::to_string(i)));
+    ASSERT_EQ(81, cache.size());
+
+    // Each forget makes only its own entry evictable, so pruning brings the
+    // cache back to the target size one entry at a time
+    for (auto inode : inodes)
+        cache.forget(inode, 1);
+    ASSERT_EQ(64, cache.size());
+
+    // With enough evictable entries, a single prune evicts a whole batch down
+    // to the target size minus 1/16
+    cache.lookup("uuid80");
+    ASSERT_EQ(60, cache.size());
+
+    for (int i = 81; i < 85; ++i)
+        cache.lookup("uuid" + std::to_string(i));
+    ASSERT_EQ(64, cache.size());
+
+    cache.lookup("uuid85");
+    ASSERT_EQ(60, cache.size());
+}
+
+TEST(InodeCacheTest, erasedEntriesShouldNotBreakLookups)
+{
+    InodeCache cache{"rootUuid"};
+
+    const auto inode = cache.lookup("liveUuid");
+
+    // Each erased entry leaves tombstones, which are purged on rehash
+    for (int i = 0; i < 10000; ++i) {
+        const auto uuid = "uuid" + std::to_string(i);
+        const auto deletedInode = cache.lookup(uuid);
+        cache.markDeleted(uuid);
+        cache.forget(deletedInode, 1);
+        ASSERT_THROW(cache.at(deletedInode), std::out_of_range);
+    }
+
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ("liveUuid", cache.at(inode));
+    ASSERT_EQ(inode, cache.lookup("liveUuid"));
+}
+
+TEST(InodeCacheTest, renameOntoExistingUuidShouldDropRenamedEntry)
+{
+    InodeCache cache{"rootUuid"};
+
+    const auto inode1 = cache.lookup("uuid1");
+    const auto inode2 = cache.lookup("uuid2");
+    cache.rename("uuid1", "uuid2");
+
+    ASSERT_EQ(2, cache.size());
+    ASSERT_THROW(cache.at(inode1), std::out_of_range);
+    ASSERT_EQ("uuid2", cache.at(inode2));
+    ASSERT_EQ(inode2, cache.lookup("uuid2"));
+}
@@ -0,0 +1,93 @@
+/**
+ * @file lru_metadata_cache_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/lruMetadataCache.h"
+#include "communication/communicator.h"
+#include "messages/fuse/fileAttr.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client;
+using namespace one::client::cache;
+
+namespace {
+std::shared_ptr<messages::fuse::FileAttr> fileAttr(const std::string &uuid)
+{
+    one::clproto::FileAttr attr;
+    attr.set_uuid(uuid);
+    attr.set_name(uuid);
+    attr.set_mode(0644);
+    attr.set_uid(0);
+    attr.set_gid(0);
+    attr.set_mtime(0);
+    attr.set_atime(0);
+    attr.set_ctime(0);
+    attr.set_type(one::clproto::FileType::REG);
+    attr.set_owner_id("");
+    attr.set_provider_id("");
+
+    return std::make_shared<messages::fuse::FileAttr>(attr);
+}
+} // namespace
+
+class LRUMetadataCacheTest : public ::testing::Test {
+protected:
+    LRUMetadataCacheTest()
+    {
+        cache.onPrune([this](const folly::fbstring &uuid) {
+            pruned.emplace_back(uuid.toStdString());
+        });
+    }
+
+    communication::Communicator communicator{1, 1, "127.0.0.1", 80, false};
+    LRUMetadataCache cache{communicator, 2, std::chrono::seconds{10}, true};
+    std::vector<std::string> pruned;
+};
+
+TEST_F(LRUMetadataCacheTest, clockEvictionShouldEvictOldestUnreferencedEntry)
+{
+    cache.putAttr(fileAttr("a"));
+    cache.putAttr(fileAttr("b"));
+    cache.putAttr(fileAttr("c"));
+
+    EXPECT_EQ(std::vector<std::string>{"a"}, pruned);
+}
+
+TEST_F(LRUMetadataCacheTest, clockEvictionShouldGiveReferencedEntryNewChance)
+{
+    cache.putAttr(fileAttr("a"));
+    cache.putAttr(fileAttr("b"));
+    EXPECT_EQ("a", cache.getAttr("a")->uuid());
+    cache.putAttr(fileAttr("c"));
+
+    EXPECT_EQ(std::vector<std::string>{"b"}, pruned);
+
+    // The clock hand has moved 'a' behind 'c', so 'c' goes next
+    cache.putAttr(fileAttr("d"));
+
+    EXPECT_EQ((std::vector<std::string>{"b", "c"}), pruned);
+}
+
+TEST_F(LRUMetadataCacheTest, putAttrsShouldPruneOnceForWholeBatch)
+{
+    cache.putAttr(fileAttr("a"));
+
+    folly::fbvector<messages::fuse::FileAttr> attrs;
+    for (const auto &uuid : {"a", "b", "c", "d"})
+        attrs.emplace_back(*fileAttr(uuid));
+
+    cache.putAttrs(std::move(attrs));
+
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), pruned);
+    EXPECT_EQ("c", cache.getAttr("c")->uuid());
+    EXPECT_EQ("d", cache.getAttr("d")->uuid());
+}
@@ -66,3 +66,20 @@ TEST_F(ReaddirCacheTest, dirCacheEntryUniqueShouldWork)
     e.unique();
     ASSERT_EQ(e.dirEntries().size(), 3);
 }
+
+TEST_F(ReaddirCacheTest, dirCacheEntryInsertAndRemoveShouldWork)
+{
+    DirCacheEntry e(2000ms);
+
+    e.addEntry("file1");
+    e.addEntry("file2");
+
+    ASSERT_FALSE(e.insertEntry("file1"));
+    ASSERT_TRUE(e.insertEntry("file3"));
+    ASSERT_EQ(e.dirEntries().back(), "file3");
+    ASSERT_EQ(e.dirEntries().size(), 3);
+
+    ASSERT_TRUE(e.removeEntry("file2"));
+    ASSERT_FALSE(e.removeEntry("file2"));
+    ASSERT_EQ(e.dirEntries(), (std::list<folly::fbstring>{"file1", "file3"}));
+}
@@ -30,3 +30,41 @@ TEST_F(AsyncStreamTest, flushShouldForwardCall)
     ASSERT_TRUE(this->mockStream->flushCalled.get_future().get());
     ASSERT_NE(this->threadId, this->mockStream->threadId.get_future().get());
 }
+
+TEST_F(AsyncStreamTest, flushKeyShouldForwardCall)
+{
+    this->stream.flush("1");
+    ASSERT_TRUE(this->mockStream->flushKeyCalled.get_future().get());
+    ASSERT_NE(this->threadId, this->mockStream->threadId.get_future().get());
+}
+
+TEST(AsyncStreamExecutorTest, isWorkerThreadShouldDetectWorkerThreads)
+{
+    auto executor = AsyncStreamExecutor::instance();
+    EXPECT_FALSE(executor->isWorkerThread());
+
+    std::promise<bool> inWorker;
+    asio::post(executor->ioService(),
+        [&] { inWorker.set_value(executor->isWorkerThread()); });
+    EXPECT_TRUE(inWorker.get_future().get());
+}
+
+TEST(AsyncStreamExecutorTest, lastReferenceShouldBeReleasableInWorkerThread)
+{
+    auto executor = AsyncStreamExecutor::instance();
+    auto &ioService = executor->ioService();
+
+    std::promise<void> released;
+    asio::post(ioService,
+        [ executor = std::move(executor), &released ]() mutable {
+            executor.reset();
+            released.set_value();
+        });
+
+    released.get_future().get();
+
+    auto newExecutor = AsyncStreamExecutor::instance();
+    std::promise<void> processed;
+    asio::post(newExecutor->ioService(), [&] { processed.set_value(); });
+    processed.get_future().get();
+}
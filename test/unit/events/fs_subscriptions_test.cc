@@ -179,3 +179,88 @@ TEST_F(FsSubscriptionsTest, subscribeFileRenamedShouldUseProperStream)
     this->fsSubscriptions.subscribeFileRenamed("fileUuid");
     ASSERT_EQ(StreamKey::FILE_RENAMED, this->streamKey);
 }
+
+TEST_F(FsSubscriptionsTest,
+    subscribeDirectoryScopedShouldShareParentSubscriptions)
+{
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(3);
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid1", "dirUuid");
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid2", "dirUuid");
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid2", "dirUuid");
+}
+
+TEST_F(FsSubscriptionsTest,
+    subscribeDirectoryScopedShouldSubscribeFileWithoutParent)
+{
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(3);
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid", "");
+    ASSERT_TRUE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid"));
+}
+
+TEST_F(FsSubscriptionsTest,
+    unsubscribeDirectoryScopedShouldUnsubscribeAfterLastChild)
+{
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid1", "dirUuid");
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid2", "dirUuid");
+
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(0);
+    ASSERT_TRUE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid1"));
+    Mock::VerifyAndClearExpectations(&this->mockManager);
+
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(3);
+    ASSERT_TRUE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid2"));
+    ASSERT_FALSE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid2"));
+}
+
+TEST_F(FsSubscriptionsTest,
+    renameDirectoryScopedShouldKeepSubscriptionsWithinParent)
+{
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid", "dirUuid");
+
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(0);
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(0);
+    this->fsSubscriptions.renameDirectoryScoped(
+        "fileUuid", "newFileUuid", "dirUuid");
+    Mock::VerifyAndClearExpectations(&this->mockManager);
+
+    EXPECT_FALSE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid"));
+
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(3);
+    EXPECT_TRUE(
+        this->fsSubscriptions.unsubscribeDirectoryScoped("newFileUuid"));
+}
+
+TEST_F(FsSubscriptionsTest, renameDirectoryScopedShouldRescopeToNewParent)
+{
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid", "dirUuid");
+
+    // Subscriptions of the new parent are added and the ones of the old
+    // parent, left without cached children, are removed
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(3);
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(3);
+    this->fsSubscriptions.renameDirectoryScoped(
+        "fileUuid", "newFileUuid", "newDirUuid");
+    Mock::VerifyAndClearExpectations(&this->mockManager);
+
+    // A sibling in the new parent shares its subscriptions
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(0);
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid2", "newDirUuid");
+    Mock::VerifyAndClearExpectations(&this->mockManager);
+
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(3);
+    EXPECT_TRUE(
+        this->fsSubscriptions.unsubscribeDirectoryScoped("newFileUuid"));
+    EXPECT_TRUE(this->fsSubscriptions.unsubscribeDirectoryScoped("fileUuid2"));
+}
+
+TEST_F(FsSubscriptionsTest,
+    renameDirectoryScopedShouldKeepOldParentSubscriptionsForSiblings)
+{
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid1", "dirUuid");
+    this->fsSubscriptions.subscribeDirectoryScoped("fileUuid2", "dirUuid");
+
+    EXPECT_CALL(this->mockManager, subscribe(_)).Times(3);
+    EXPECT_CALL(this->mockManager, unsubscribe(_)).Times(0);
+    this->fsSubscriptions.renameDirectoryScoped(
+        "fileUuid1", "fileUuid1", "newDirUuid");
+}
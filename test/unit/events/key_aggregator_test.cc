@@ -34,3 +34,21 @@ TYPED_TEST(KeyAggregatorTest, flushShouldBeEmpty)
 {
     ASSERT_TRUE(this->aggregator.flush().empty());
 }
+
+TYPED_TEST(KeyAggregatorTest, flushKeyShouldReturnOnlyEventWithTheKey)
+{
+    this->aggregator.process(std::make_unique<TypeParam>("1"));
+    this->aggregator.process(std::make_unique<TypeParam>("2"));
+
+    auto events = this->aggregator.flush("1");
+    ASSERT_EQ(1, events.size());
+    ASSERT_EQ("1", events.front()->aggregationKey());
+    ASSERT_EQ(1, this->aggregator.flush().size());
+}
+
+TYPED_TEST(KeyAggregatorTest, flushKeyShouldBeEmptyForMissingKey)
+{
+    this->aggregator.process(std::make_unique<TypeParam>("1"));
+    ASSERT_TRUE(this->aggregator.flush("2").empty());
+    ASSERT_EQ(1, this->aggregator.flush().size());
+}
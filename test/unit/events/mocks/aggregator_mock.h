@@ -25,8 +25,15 @@ struct MockAggregator : public one::client::events::Aggregator<T> {
         return {};
     }
 
+    Events<T> flush(const one::client::events::AggregationKey &key) override
+    {
+        flushKeyCalled = true;
+        return {};
+    }
+
     bool processCalled = false;
     bool flushCalled = false;
+    bool flushKeyCalled = false;
 };
 
 #endif // ONECLIENT_TEST_UNIT_EVENTS_AGGREGATOR_MOCK_H
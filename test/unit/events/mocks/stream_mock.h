@@ -23,8 +23,14 @@ struct MockStream : public one::client::events::Stream {
 
     void flush() override { flushCalled = true; }
 
+    void flush(const one::client::events::AggregationKey &key) override
+    {
+        flushKeyCalled = true;
+    }
+
     bool processCalled = false;
     bool flushCalled = false;
+    bool flushKeyCalled = false;
 };
 
 struct MockAsyncStream : public one::client::events::Stream {
@@ -40,9 +46,16 @@ struct MockAsyncStream : public one::client::events::Stream {
         flushCalled.set_value(true);
     }
 
+    void flush(const one::client::events::AggregationKey &key) override
+    {
+        threadId.set_value(hasher(std::this_thread::get_id()));
+        flushKeyCalled.set_value(true);
+    }
+
     std::hash<std::thread::id> hasher;
     std::promise<bool> processCalled;
     std::promise<bool> flushCalled;
+    std::promise<bool> flushKeyCalled;
     std::promise<std::size_t> threadId;
 };
 
@@ -28,6 +28,12 @@ TEST_F(SharedStreamTest, flushShouldForwardCall)
     ASSERT_TRUE(this->mockStream->flushCalled);
 }
 
+TEST_F(SharedStreamTest, flushKeyShouldForwardCall)
+{
+    this->stream.flush("1");
+    ASSERT_TRUE(this->mockStream->flushKeyCalled);
+}
+
 TEST_F(SharedStreamTest, releaseLastShareShouldReturnTrue)
 {
     ASSERT_TRUE(this->stream.release());
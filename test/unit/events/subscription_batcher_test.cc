@@ -0,0 +1,137 @@
+/**
+ * @file subscription_batcher_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "scheduler_mock.h"
+#include "utils.h"
+
+#include <chrono>
+
+using namespace ::testing;
+using namespace one::client::events;
+using namespace std::literals::chrono_literals;
+
+struct SubscriptionBatcherTest : public ::testing::Test {
+    SubscriptionBatcherTest()
+    {
+        ON_CALL(mockScheduler, schedule(_, _)).WillByDefault(Return([] {}));
+    }
+
+    ProtoSubscriptionPtr subscriptionMsg()
+    {
+        auto msg = std::make_unique<ProtoSubscription>();
+        msg->mutable_file_removed()->set_file_uuid("fileUuid");
+        return msg;
+    }
+
+    std::vector<ProtoClientPtr> sent;
+    NiceMock<MockScheduler> mockScheduler;
+    SubscriptionBatcher<MockScheduler> batcher{
+        [this](ProtoClientPtr msg) { sent.emplace_back(std::move(msg)); },
+        mockScheduler, 100ms};
+};
+
+TEST_F(SubscriptionBatcherTest, subscribeShouldNotSendImmediately)
+{
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    ASSERT_TRUE(this->sent.empty());
+}
+
+TEST_F(SubscriptionBatcherTest, subscribeShouldScheduleFlushOnce)
+{
+    EXPECT_CALL(this->mockScheduler, schedule(100ms, _))
+        .WillOnce(Return([] {}));
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    this->batcher.subscribe(2, this->subscriptionMsg());
+    this->batcher.cancel(3);
+}
+
+TEST_F(SubscriptionBatcherTest, flushShouldSendQueuedMessagesInOrder)
+{
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    this->batcher.cancel(2);
+    this->batcher.flush();
+
+    ASSERT_EQ(2, this->sent.size());
+    ASSERT_TRUE(this->sent[0]->has_subscription());
+    ASSERT_EQ(1, this->sent[0]->subscription().id());
+    ASSERT_TRUE(this->sent[1]->has_subscription_cancellation());
+    ASSERT_EQ(2, this->sent[1]->subscription_cancellation().id());
+}
+
+TEST_F(SubscriptionBatcherTest, cancelShouldDropUnsentSubscription)
+{
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    this->batcher.subscribe(2, this->subscriptionMsg());
+    this->batcher.cancel(1);
+    this->batcher.flush();
+
+    ASSERT_EQ(1, this->sent.size());
+    ASSERT_EQ(2, this->sent[0]->subscription().id());
+}
+
+TEST_F(SubscriptionBatcherTest, cancelShouldSendCancellationOfSentSubscription)
+{
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    this->batcher.flush();
+    this->batcher.cancel(1);
+    this->batcher.flush();
+
+    ASSERT_EQ(2, this->sent.size());
+    ASSERT_TRUE(this->sent[1]->has_subscription_cancellation());
+    ASSERT_EQ(1, this->sent[1]->subscription_cancellation().id());
+}
+
+TEST_F(SubscriptionBatcherTest, scheduledTaskShouldSendQueuedMessages)
+{
+    EXPECT_CALL(this->mockScheduler, schedule(_, _))
+        .WillOnce(WithArgs<1>(Invoke([](const auto &task) {
+            task();
+            return [] {};
+        })));
+
+    this->batcher.subscribe(1, this->subscriptionMsg());
+    ASSERT_EQ(1, this->sent.size());
+}
+
+TEST_F(SubscriptionBatcherTest, scheduledTaskShouldNotRunAfterDestruction)
+{
+    NiceMock<MockScheduler> mockScheduler;
+    std::vector<ProtoClientPtr> sent;
+    std::function<void()> scheduledTask;
+    EXPECT_CALL(mockScheduler, schedule(_, _))
+        .WillOnce(DoAll(SaveArg<1>(&scheduledTask), Return([] {})));
+
+    {
+        SubscriptionBatcher<MockScheduler> batcher{
+            [&](ProtoClientPtr msg) { sent.emplace_back(std::move(msg)); },
+            mockScheduler, 100ms};
+        batcher.subscribe(1, this->subscriptionMsg());
+    }
+
+    ASSERT_EQ(1, sent.size());
+    scheduledTask();
+    ASSERT_EQ(1, sent.size());
+}
+
+TEST(SubscriptionBatcherNoIntervalTest, subscribeShouldSendImmediately)
+{
+    MockScheduler mockScheduler;
+    std::vector<ProtoClientPtr> sent;
+    SubscriptionBatcher<MockScheduler> batcher{
+        [&](ProtoClientPtr msg) { sent.emplace_back(std::move(msg)); },
+        mockScheduler, 0ms};
+
+    EXPECT_CALL(mockScheduler, schedule(_, _)).Times(0);
+
+    auto msg = std::make_unique<ProtoSubscription>();
+    msg->mutable_file_removed()->set_file_uuid("fileUuid");
+    batcher.subscribe(1, std::move(msg));
+    batcher.cancel(1);
+
+    ASSERT_EQ(2, sent.size());
+}
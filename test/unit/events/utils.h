@@ -14,6 +14,7 @@
 #include "messages/fuse/fileAttr.h"
 #include "messages/fuse/fileLocation.h"
 #include "scheduler.h"
+#include "util/timingWheel.h"
 
 #include "messages.pb.h"
 
@@ -50,7 +51,7 @@ struct TestSubscription : public one::client::events::Subscription {
     one::client::events::StreamPtr createStream(
         one::client::events::Manager &manager,
         one::client::events::SequencerManager &seqManager,
-        one::Scheduler &scheduler) const override
+        one::client::util::TimingWheel &timingWheel) const override
     {
         using namespace one::client::events;
 
@@ -205,6 +206,7 @@ std::shared_ptr<one::client::Context> testContext()
 {
     auto context = std::make_shared<one::client::Context>();
     context->setScheduler(std::make_shared<one::Scheduler>(0));
+    context->setTimingWheel(std::make_shared<one::client::util::TimingWheel>());
     context->setCommunicator(std::make_shared<one::communication::Communicator>(
         1, 1, "127.0.0.1", 80, false));
     return context;
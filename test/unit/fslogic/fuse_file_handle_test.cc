@@ -0,0 +1,164 @@
+/**
+ * @file fuse_file_handle_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/forceProxyIOCache.h"
+#include "cache/helpersCache.h"
+#include "communication/communicator.h"
+#include "fslogic/fuseFileHandle.h"
+#include "options/options.h"
+#include "scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <thread>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client;
+using namespace one::client::fslogic;
+using namespace one::messages::fuse;
+
+using Interval = boost::icl::discrete_interval<off_t>;
+
+class FuseFileHandleTest : public ::testing::Test {
+protected:
+    options::Options options;
+    Scheduler scheduler{0};
+    communication::Communicator communicator{1, 1, "127.0.0.1", 80, false};
+    cache::HelpersCache helpersCache{communicator, scheduler, options};
+    cache::ForceProxyIOCache forceProxyIOCache;
+    FuseFileHandle handle{O_RDWR, "handleId", nullptr, helpersCache,
+        forceProxyIOCache, std::chrono::seconds{10}};
+};
+
+TEST_F(FuseFileHandleTest, addPendingWriteShouldMergeAdjacentRanges)
+{
+    EXPECT_FALSE(handle.addPendingWrite(
+        "uuid", Interval::right_open(0, 10), FileBlock{"s1", "f1"}));
+    EXPECT_FALSE(handle.addPendingWrite(
+        "uuid", Interval::right_open(10, 20), FileBlock{"s1", "f1"}));
+    EXPECT_FALSE(handle.addPendingWrite(
+        "uuid", Interval::right_open(20, 30), FileBlock{"s1", "f1"}));
+
+    EXPECT_EQ(30, handle.pendingWriteSize());
+
+    auto pendingWrite = handle.takePendingWrite();
+    ASSERT_TRUE(pendingWrite);
+    EXPECT_EQ(Interval::right_open(0, 30), pendingWrite->range);
+    EXPECT_EQ(0, handle.pendingWriteSize());
+}
+
+TEST_F(FuseFileHandleTest, addPendingWriteShouldMergeOverlappingRanges)
+{
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(10, 20), FileBlock{"s1", "f1"});
+    EXPECT_FALSE(handle.addPendingWrite(
+        "uuid", Interval::right_open(5, 15), FileBlock{"s1", "f1"}));
+    EXPECT_FALSE(handle.addPendingWrite(
+        "uuid", Interval::right_open(12, 14), FileBlock{"s1", "f1"}));
+
+    EXPECT_EQ(15, handle.pendingWriteSize());
+    EXPECT_EQ(Interval::right_open(5, 20), handle.takePendingWrite()->range);
+}
+
+TEST_F(FuseFileHandleTest, addPendingWriteShouldSplitOnGap)
+{
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(0, 10), FileBlock{"s1", "f1"});
+
+    auto previousWrite = handle.addPendingWrite(
+        "uuid", Interval::right_open(11, 20), FileBlock{"s1", "f1"});
+
+    ASSERT_TRUE(previousWrite);
+    EXPECT_EQ(Interval::right_open(0, 10), previousWrite->range);
+    EXPECT_EQ(9, handle.pendingWriteSize());
+}
+
+TEST_F(FuseFileHandleTest, addPendingWriteShouldSplitOnDifferentFileBlock)
+{
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(0, 10), FileBlock{"s1", "f1"});
+
+    auto previousWrite = handle.addPendingWrite(
+        "uuid", Interval::right_open(10, 20), FileBlock{"s2", "f1"});
+
+    ASSERT_TRUE(previousWrite);
+    EXPECT_EQ("s1", previousWrite->fileBlock.storageId());
+
+    previousWrite = handle.addPendingWrite(
+        "uuid", Interval::right_open(20, 30), FileBlock{"s2", "f2"});
+
+    ASSERT_TRUE(previousWrite);
+    EXPECT_EQ("f1", previousWrite->fileBlock.fileId());
+    EXPECT_EQ(Interval::right_open(10, 20), previousWrite->range);
+}
+
+TEST_F(FuseFileHandleTest, addPendingWriteShouldSplitOnDifferentUuid)
+{
+    handle.addPendingWrite(
+        "uuid1", Interval::right_open(0, 10), FileBlock{"s1", "f1"});
+
+    auto previousWrite = handle.addPendingWrite(
+        "uuid2", Interval::right_open(10, 20), FileBlock{"s1", "f1"});
+
+    ASSERT_TRUE(previousWrite);
+    EXPECT_EQ("uuid1", previousWrite->uuid);
+    EXPECT_TRUE(handle.hasPendingWrite("uuid2"));
+    EXPECT_FALSE(handle.hasPendingWrite("uuid1"));
+}
+
+TEST_F(FuseFileHandleTest, pendingWriteSinceShouldNotChangeOnMerge)
+{
+    EXPECT_FALSE(handle.pendingWriteSince());
+
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(0, 10), FileBlock{"s1", "f1"});
+    const auto since = handle.pendingWriteSince();
+    ASSERT_TRUE(since);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(10, 20), FileBlock{"s1", "f1"});
+    EXPECT_EQ(*since, *handle.pendingWriteSince());
+
+    handle.addPendingWrite(
+        "uuid", Interval::right_open(30, 40), FileBlock{"s1", "f1"});
+    EXPECT_LT(*since, *handle.pendingWriteSince());
+}
+
+TEST_F(FuseFileHandleTest, addPendingReadShouldSumRepeatedReads)
+{
+    for (int i = 0; i < 4; ++i)
+        EXPECT_FALSE(
+            handle.addPendingRead("uuid", Interval::right_open(0, 10)));
+
+    EXPECT_EQ(40, handle.pendingReadSize());
+
+    auto pendingRead = handle.takePendingRead();
+    ASSERT_TRUE(pendingRead);
+    EXPECT_EQ(Interval::right_open(0, 10), pendingRead->range);
+    EXPECT_EQ(40, pendingRead->size);
+    EXPECT_EQ(4, pendingRead->counter);
+}
+
+TEST_F(FuseFileHandleTest, addPendingReadShouldSplitOnGap)
+{
+    handle.addPendingRead("uuid", Interval::right_open(0, 10));
+    handle.addPendingRead("uuid", Interval::right_open(10, 20));
+
+    auto previousRead =
+        handle.addPendingRead("uuid", Interval::right_open(30, 35));
+
+    ASSERT_TRUE(previousRead);
+    EXPECT_EQ(Interval::right_open(0, 20), previousRead->range);
+    EXPECT_EQ(20, previousRead->size);
+    EXPECT_EQ(2, previousRead->counter);
+    EXPECT_EQ(5, handle.pendingReadSize());
+    EXPECT_TRUE(handle.pendingReadSince());
+}
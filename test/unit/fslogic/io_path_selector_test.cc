@@ -0,0 +1,93 @@
+/**
+ * @file io_path_selector_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/ioPathSelector.h"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one::client::fslogic;
+using namespace std::literals;
+
+class IOPathSelectorTest : public ::testing::Test {
+protected:
+    void recordSamples(const IOPath path, const std::size_t bytes,
+        const std::chrono::microseconds duration, const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            selector.recordSample("s1", path, bytes, duration);
+    }
+
+    IOPathSelector selector{0.1};
+};
+
+TEST_F(IOPathSelectorTest, directPathShouldBePreferredByDefault)
+{
+    EXPECT_TRUE(selector.enabled());
+    EXPECT_EQ(IOPath::DIRECT, selector.preferredPath("s1"));
+    EXPECT_FALSE(selector.cost("s1", IOPath::DIRECT));
+}
+
+TEST_F(IOPathSelectorTest, selectorShouldSwitchToFasterPath)
+{
+    recordSamples(IOPath::DIRECT, 1024 * 1024, 10ms, IO_PATH_MIN_SAMPLES);
+    recordSamples(IOPath::PROXY, 1024 * 1024, 5ms, IO_PATH_MIN_SAMPLES - 1);
+    EXPECT_EQ(IOPath::DIRECT, selector.preferredPath("s1"));
+
+    recordSamples(IOPath::PROXY, 1024 * 1024, 5ms, 1);
+    EXPECT_EQ(IOPath::PROXY, selector.preferredPath("s1"));
+    EXPECT_EQ(IOPath::DIRECT, selector.preferredPath("s2"));
+
+    recordSamples(IOPath::DIRECT, 1024 * 1024, 1ms, 20);
+    EXPECT_EQ(IOPath::DIRECT, selector.preferredPath("s1"));
+}
+
+TEST_F(IOPathSelectorTest, selectorShouldNotSwitchWithinHysteresis)
+{
+    recordSamples(IOPath::DIRECT, 1024 * 1024, 10ms, IO_PATH_MIN_SAMPLES);
+    recordSamples(IOPath::PROXY, 1024 * 1024, 9ms, IO_PATH_MIN_SAMPLES);
+
+    EXPECT_EQ(IOPath::DIRECT, selector.preferredPath("s1"));
+}
+
+TEST_F(IOPathSelectorTest, costShouldBeNormalizedToTransferredData)
+{
+    recordSamples(IOPath::DIRECT, 1024 * 1024, 10ms, 1);
+    recordSamples(IOPath::PROXY, 512 * 1024, 10ms, 1);
+
+    EXPECT_NEAR(10'000, *selector.cost("s1", IOPath::DIRECT), 1);
+    EXPECT_NEAR(20'000, *selector.cost("s1", IOPath::PROXY), 1);
+
+    // Small operations are dominated by latency
+    selector.recordSample("s2", IOPath::DIRECT, 0, 1ms);
+    EXPECT_NEAR(16'000, *selector.cost("s2", IOPath::DIRECT), 1);
+}
+
+TEST_F(IOPathSelectorTest, chooseShouldProbeAlternativePath)
+{
+    std::size_t proxied = 0;
+    for (int i = 0; i < 10'000; ++i) {
+        if (selector.choose("s1") == IOPath::PROXY)
+            ++proxied;
+    }
+
+    EXPECT_GT(proxied, 500);
+    EXPECT_LT(proxied, 1'500);
+}
+
+TEST(IOPathSelectorDisabledTest, disabledSelectorShouldAlwaysChooseDirect)
+{
+    IOPathSelector selector{0.0};
+
+    EXPECT_FALSE(selector.enabled());
+    for (int i = 0; i < 1'000; ++i)
+        EXPECT_EQ(IOPath::DIRECT, selector.choose("s1"));
+
+    selector.recordSample("s1", IOPath::PROXY, 1024 * 1024, 1ms);
+    EXPECT_FALSE(selector.cost("s1", IOPath::PROXY));
+}
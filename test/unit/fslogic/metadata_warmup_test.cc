@@ -0,0 +1,58 @@
+/**
+ * @file metadata_warmup_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/metadataWarmup.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ::testing;
+using namespace one::client::fslogic;
+
+TEST(MetadataWarmupTest, parseManifestShouldSplitPathsIntoComponents)
+{
+    std::istringstream manifest{"# software environments\n"
+                                "space1/envs/python3.7\n"
+                                "\n"
+                                "  /space1//models/./bert/  \n"
+                                "space2/genomes/*.fa\n"};
+
+    auto paths = parseMetadataWarmupManifest(manifest);
+
+    ASSERT_EQ(3, paths.size());
+    EXPECT_EQ((MetadataWarmupPath{"space1", "envs", "python3.7"}), paths[0]);
+    EXPECT_EQ((MetadataWarmupPath{"space1", "models", "bert"}), paths[1]);
+    EXPECT_EQ((MetadataWarmupPath{"space2", "genomes", "*.fa"}), paths[2]);
+}
+
+TEST(MetadataWarmupTest, parseManifestShouldSkipParentDirectoryReferences)
+{
+    std::istringstream manifest{"space1/../space2\n"
+                                "/\n"
+                                "space1/data\n"};
+
+    auto paths = parseMetadataWarmupManifest(manifest);
+
+    ASSERT_EQ(1, paths.size());
+    EXPECT_EQ((MetadataWarmupPath{"space1", "data"}), paths[0]);
+}
+
+TEST(MetadataWarmupTest, patternsShouldMatchLikeShellGlobs)
+{
+    EXPECT_FALSE(isMetadataWarmupPattern("genome.fa"));
+    EXPECT_TRUE(isMetadataWarmupPattern("*.fa"));
+    EXPECT_TRUE(isMetadataWarmupPattern("chr?"));
+    EXPECT_TRUE(isMetadataWarmupPattern("chr[0-9]"));
+
+    EXPECT_TRUE(matchesMetadataWarmupPattern("*.fa", "hg38.fa"));
+    EXPECT_FALSE(matchesMetadataWarmupPattern("*.fa", "hg38.fa.fai"));
+    EXPECT_TRUE(matchesMetadataWarmupPattern("chr[0-9]", "chr7"));
+    EXPECT_FALSE(matchesMetadataWarmupPattern("*", ".hidden"));
+    EXPECT_TRUE(matchesMetadataWarmupPattern(".*", ".hidden"));
+}
@@ -0,0 +1,132 @@
+/**
+ * @file storage_health_tracker_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/storageHealthTracker.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace ::testing;
+using namespace one::client::fslogic;
+using namespace std::literals;
+
+using BreakerState = StorageHealthTracker::BreakerState;
+
+class StorageHealthTrackerTest : public ::testing::Test {
+protected:
+    StorageHealthTracker tracker{3};
+};
+
+TEST_F(StorageHealthTrackerTest, breakerShouldOpenAfterConsecutiveFailures)
+{
+    tracker.recordFailure("s1");
+    tracker.recordFailure("s1");
+    EXPECT_TRUE(tracker.allowRequest("s1"));
+
+    tracker.recordFailure("s1");
+    EXPECT_EQ(BreakerState::OPEN, tracker.breakerState("s1"));
+    EXPECT_FALSE(tracker.allowRequest("s1"));
+
+    EXPECT_EQ(BreakerState::CLOSED, tracker.breakerState("s2"));
+    EXPECT_TRUE(tracker.allowRequest("s2"));
+}
+
+TEST_F(StorageHealthTrackerTest, successShouldResetConsecutiveFailures)
+{
+    tracker.recordFailure("s1");
+    tracker.recordFailure("s1");
+    tracker.recordSuccess("s1", 10ms);
+    tracker.recordFailure("s1");
+    tracker.recordFailure("s1");
+
+    EXPECT_EQ(BreakerState::CLOSED, tracker.breakerState("s1"));
+}
+
+TEST_F(StorageHealthTrackerTest, breakerShouldLetProbeThroughAfterCooldown)
+{
+    for (int i = 0; i < 3; ++i)
+        tracker.recordFailure("s1");
+
+    std::this_thread::sleep_for(STORAGE_BREAKER_MIN_COOLDOWN);
+
+    EXPECT_TRUE(tracker.allowRequest("s1"));
+    EXPECT_EQ(BreakerState::HALF_OPEN, tracker.breakerState("s1"));
+    EXPECT_FALSE(tracker.allowRequest("s1"));
+
+    tracker.recordSuccess("s1", 10ms);
+    EXPECT_EQ(BreakerState::CLOSED, tracker.breakerState("s1"));
+    EXPECT_TRUE(tracker.allowRequest("s1"));
+}
+
+TEST_F(StorageHealthTrackerTest, failedProbeShouldOpenBreakerAgain)
+{
+    for (int i = 0; i < 3; ++i)
+        tracker.recordFailure("s1");
+
+    std::this_thread::sleep_for(STORAGE_BREAKER_MIN_COOLDOWN);
+
+    EXPECT_TRUE(tracker.allowRequest("s1"));
+    tracker.recordFailure("s1");
+
+    EXPECT_EQ(BreakerState::OPEN, tracker.breakerState("s1"));
+    EXPECT_FALSE(tracker.allowRequest("s1"));
+}
+
+TEST_F(StorageHealthTrackerTest, retryDelayShouldGrowWithFailures)
+{
+    EXPECT_FALSE(tracker.retryDelay("s1"));
+
+    tracker.recordFailure("s1");
+    EXPECT_EQ(STORAGE_HEALTH_MIN_RETRY_DELAY, *tracker.retryDelay("s1"));
+
+    for (int i = 0; i < 32; ++i)
+        tracker.recordFailure("s1");
+
+    for (int i = 0; i < 10; ++i) {
+        auto delay = *tracker.retryDelay("s1");
+        EXPECT_GE(delay, STORAGE_HEALTH_MIN_RETRY_DELAY);
+        EXPECT_LE(delay, STORAGE_HEALTH_MAX_RETRY_DELAY);
+    }
+
+    tracker.recordSuccess("s1", 10ms);
+    EXPECT_FALSE(tracker.retryDelay("s1"));
+}
+
+TEST_F(StorageHealthTrackerTest, latencyShouldBeMovingAverage)
+{
+    EXPECT_FALSE(tracker.latency("s1"));
+
+    tracker.recordSuccess("s1", 100us);
+    EXPECT_EQ(100us, *tracker.latency("s1"));
+
+    tracker.recordSuccess("s1", 200us);
+    EXPECT_NEAR(120, tracker.latency("s1")->count(), 1);
+}
+
+TEST(StorageHealthTrackerDisabledTest, breakerShouldNeverOpenIfDisabled)
+{
+    StorageHealthTracker tracker{0};
+
+    for (int i = 0; i < 100; ++i)
+        tracker.recordFailure("s1");
+
+    EXPECT_EQ(BreakerState::CLOSED, tracker.breakerState("s1"));
+    EXPECT_TRUE(tracker.allowRequest("s1"));
+}
+
+TEST(StorageHealthTrackerDisabledTest, disabledBreakerShouldNotOverrideDelays)
+{
+    StorageHealthTracker tracker{0};
+
+    for (int i = 0; i < 10; ++i)
+        tracker.recordFailure("s1");
+
+    // Retries fall back to the default FsLogic retry delays
+    EXPECT_FALSE(tracker.retryDelay("s1"));
+}
@@ -0,0 +1,116 @@
+/**
+ * @file write_back_journal_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/writeBackJournal.h"
+
+#include <folly/io/IOBuf.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one::client::fslogic;
+
+namespace {
+std::string toString(const folly::IOBuf &buf)
+{
+    return buf.cloneCoalescedAsValue().moveToFbString().toStdString();
+}
+} // namespace
+
+class WriteBackJournalTest : public ::testing::Test {
+protected:
+    WriteBackJournal journal{boost::filesystem::temp_directory_path(), 1};
+};
+
+TEST_F(WriteBackJournalTest, newJournalShouldBeEmpty)
+{
+    EXPECT_TRUE(journal.empty());
+    EXPECT_EQ(0, journal.dirtySize());
+    EXPECT_EQ(1, journal.fuseFileHandleId());
+}
+
+TEST_F(WriteBackJournalTest, appendShouldStoreEntries)
+{
+    journal.append("uuid", 100, *folly::IOBuf::copyBuffer("abcd"));
+    journal.append("uuid", 0, *folly::IOBuf::copyBuffer("efghijk"));
+
+    EXPECT_FALSE(journal.empty());
+    EXPECT_EQ(11, journal.dirtySize());
+    EXPECT_EQ("uuid", journal.uuid());
+
+    EXPECT_EQ(100, journal.front().offset);
+    EXPECT_EQ(4, journal.front().size);
+}
+
+TEST_F(WriteBackJournalTest, appendShouldStoreChainedBuffers)
+{
+    auto buf = folly::IOBuf::copyBuffer("abc");
+    buf->prependChain(folly::IOBuf::copyBuffer("def"));
+
+    journal.append("uuid", 0, *buf);
+
+    EXPECT_EQ(6, journal.front().size);
+    EXPECT_EQ("abcdef", toString(*journal.read(journal.front())));
+}
+
+TEST_F(WriteBackJournalTest, readShouldReturnEntryData)
+{
+    journal.append("uuid", 100, *folly::IOBuf::copyBuffer("abcd"));
+    journal.append("uuid", 0, *folly::IOBuf::copyBuffer("efghijk"));
+
+    EXPECT_EQ("abcd", toString(*journal.read(journal.front())));
+
+    journal.popFront();
+
+    EXPECT_EQ(0, journal.front().offset);
+    EXPECT_EQ("efghijk", toString(*journal.read(journal.front())));
+}
+
+TEST_F(WriteBackJournalTest, popFrontShouldRemoveOldestEntry)
+{
+    journal.append("uuid", 0, *folly::IOBuf::copyBuffer("abcd"));
+    journal.append("uuid", 4, *folly::IOBuf::copyBuffer("ef"));
+
+    journal.popFront();
+    EXPECT_FALSE(journal.empty());
+    EXPECT_EQ(2, journal.dirtySize());
+
+    journal.popFront();
+    EXPECT_TRUE(journal.empty());
+    EXPECT_EQ(0, journal.dirtySize());
+}
+
+TEST_F(WriteBackJournalTest, appendShouldReuseJournalSpaceAfterDrain)
+{
+    journal.append("uuid", 0, *folly::IOBuf::copyBuffer("abcd"));
+    journal.popFront();
+
+    journal.append("uuid", 10, *folly::IOBuf::copyBuffer("xyz"));
+
+    EXPECT_EQ(0, journal.front().journalOffset);
+    EXPECT_EQ("xyz", toString(*journal.read(journal.front())));
+}
+
+TEST_F(WriteBackJournalTest, rethrowErrorShouldRethrowStoredErrorOnce)
+{
+    EXPECT_NO_THROW(journal.rethrowError());
+
+    journal.setError(std::make_exception_ptr(
+        std::system_error{std::make_error_code(std::errc::io_error)}));
+
+    EXPECT_THROW(journal.rethrowError(), std::system_error);
+    EXPECT_NO_THROW(journal.rethrowError());
+}
+
+TEST_F(WriteBackJournalTest, scheduleUploadShouldBeIdempotentUntilStarted)
+{
+    EXPECT_TRUE(journal.scheduleUpload());
+    EXPECT_FALSE(journal.scheduleUpload());
+
+    journal.startUpload();
+    EXPECT_TRUE(journal.scheduleUpload());
+}
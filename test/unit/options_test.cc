@@ -91,10 +91,16 @@ TEST_F(OptionsTest, getOptionShouldReturnDefaultValue)
     EXPECT_EQ(false, options.isIOTraceLoggerEnabled());
     EXPECT_EQ(false, options.isProxyIOForced());
     EXPECT_EQ(false, options.isDirectIOForced());
+    EXPECT_EQ(false, options.isStorageDetectionOnMountEnabled());
+    EXPECT_FALSE(options.getStorageAccessStateFilePath());
+    EXPECT_EQ(0, options.getHelperParamsRefreshInterval().count());
+    EXPECT_FALSE(options.getMetadataWarmupManifestPath());
+    EXPECT_EQ(false, options.isMetadataWarmupLocationsEnabled());
     EXPECT_EQ(false, options.isMonitoringEnabled());
     EXPECT_EQ(false, options.isMonitoringLevelFull());
     EXPECT_EQ(false, options.areFileReadEventsDisabled());
     EXPECT_EQ(true, options.isFullblockReadEnabled());
+    EXPECT_EQ(true, options.isFsyncOnReleaseEnabled());
     EXPECT_EQ(true, options.isMonitoringLevelBasic());
     EXPECT_EQ(false, options.isClusterPrefetchThresholdRandom());
     EXPECT_EQ(0, options.getVerboseLogLevel());
@@ -132,6 +138,28 @@ TEST_F(OptionsTest, getOptionShouldReturnDefaultValue)
         options::DEFAULT_METADATA_CACHE_SIZE, options.getMetadataCacheSize());
     EXPECT_EQ(options::DEFAULT_READDIR_PREFETCH_SIZE,
         options.getReaddirPrefetchSize());
+    EXPECT_EQ(options::DEFAULT_READDIR_PREFETCH_FANOUT,
+        options.getReaddirPrefetchFanout());
+    EXPECT_EQ(options::DEFAULT_WRITE_EXTENT_BATCH_SIZE,
+        options.getWriteExtentBatchSize());
+    EXPECT_EQ(
+        options::DEFAULT_MAX_ASYNC_RELEASES, options.getMaxAsyncReleases());
+    EXPECT_EQ(options::DEFAULT_HELPER_HANDLE_POOL_SIZE,
+        options.getHelperHandlePoolSize());
+    EXPECT_EQ(options::DEFAULT_STORAGE_CIRCUIT_BREAKER_THRESHOLD,
+        options.getStorageCircuitBreakerThreshold());
+    EXPECT_EQ(options::DEFAULT_IO_PATH_PROBE_RATIO,
+        options.getIOPathProbeRatio());
+    EXPECT_FALSE(options.getWriteBackDirPath());
+    EXPECT_EQ(options::DEFAULT_WRITE_BACK_FILE_DIRTY_LIMIT,
+        options.getWriteBackFileDirtyLimit());
+    EXPECT_EQ(options::DEFAULT_WRITE_BACK_DIRTY_LIMIT,
+        options.getWriteBackDirtyLimit());
+    EXPECT_EQ(options::DEFAULT_WRITE_BACK_DURABILITY,
+        options.getWriteBackDurability());
+    EXPECT_FALSE(options.areDirectorySubscriptionsEnabled());
+    EXPECT_FALSE(options.areDeterministicInodesEnabled());
+    EXPECT_FALSE(options.isMetadataCacheClockEnabled());
     EXPECT_EQ(1.0, options.getLinearReadPrefetchThreshold());
     EXPECT_EQ(1.0, options.getRandomReadPrefetchThreshold());
     EXPECT_EQ(options::DEFAULT_PREFETCH_CLUSTER_WINDOW_SIZE,
@@ -268,6 +296,42 @@ TEST_F(OptionsTest, parseCommandLineShouldSetForceDirectIO)
     EXPECT_EQ(true, options.isDirectIOForced());
 }
 
+TEST_F(OptionsTest, parseCommandLineShouldEnableStorageDetectionOnMount)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--detect-storages-on-mount", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.isStorageDetectionOnMountEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetStorageAccessStateFile)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--storage-access-state-file", "/tmp/storages", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(
+        "/tmp/storages", options.getStorageAccessStateFilePath()->string());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetHelperParamsRefreshInterval)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--helper-params-refresh-interval", "600", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(600, options.getHelperParamsRefreshInterval().count());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetMetadataWarmup)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--metadata-warmup-manifest", "/tmp/hot-paths",
+            "--metadata-warmup-locations", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(
+        "/tmp/hot-paths", options.getMetadataWarmupManifestPath()->string());
+    EXPECT_TRUE(options.isMetadataWarmupLocationsEnabled());
+}
+
 TEST_F(OptionsTest, parseCommandLineShouldSetBufferSchedulerThreadCount)
 {
     cmdArgs.insert(
@@ -329,6 +393,13 @@ TEST_F(OptionsTest, parseCommandLineShouldEnableFullblockRead)
     EXPECT_EQ(false, options.isFullblockReadEnabled());
 }
 
+TEST_F(OptionsTest, parseCommandLineShouldDisableFsyncOnRelease)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--no-fsync-on-release", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(false, options.isFsyncOnReleaseEnabled());
+}
+
 TEST_F(OptionsTest, parseCommandLineShouldSetProviderTimeout)
 {
     cmdArgs.insert(cmdArgs.end(), {"--provider-timeout", "300", "mountpoint"});
@@ -416,6 +487,97 @@ TEST_F(OptionsTest, parseCommandLineShouldSetReaddirPrefetchSize)
     EXPECT_EQ(10000, options.getReaddirPrefetchSize());
 }
 
+TEST_F(OptionsTest, parseCommandLineShouldSetReaddirPrefetchFanout)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--readdir-prefetch-fanout", "16", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(16, options.getReaddirPrefetchFanout());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetWriteExtentBatchSize)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--write-extent-batch-size", "0", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(0, options.getWriteExtentBatchSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetMaxAsyncReleases)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--max-async-releases", "100", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(100, options.getMaxAsyncReleases());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetHelperHandlePoolSize)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--helper-handle-pool-size", "256", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(256, options.getHelperHandlePoolSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetStorageCircuitBreakerThreshold)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--storage-circuit-breaker-threshold", "10", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(10, options.getStorageCircuitBreakerThreshold());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetIOPathProbeRatio)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--io-path-probe-ratio", "0.05", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(0.05, options.getIOPathProbeRatio());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetWriteBackOptions)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--write-back-dir", "/tmp/journal", "--write-back-file-dirty-limit",
+            "1024", "--write-back-dirty-limit", "8589934592",
+            "--write-back-durability", "fsync", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("/tmp/journal", options.getWriteBackDirPath()->string());
+    EXPECT_EQ(1024, options.getWriteBackFileDirtyLimit());
+    EXPECT_EQ(8589934592u, options.getWriteBackDirtyLimit());
+    EXPECT_EQ("fsync", options.getWriteBackDurability());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldRejectUnknownWriteBackDurability)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--write-back-dir", "/tmp/journal", "--write-back-durability",
+            "never", "mountpoint"});
+    EXPECT_THROW(options.parse(cmdArgs.size(), cmdArgs.data()),
+        boost::program_options::error);
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableDirectorySubscriptions)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--directory-subscriptions", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.areDirectorySubscriptionsEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableDeterministicInodes)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--deterministic-inodes", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.areDeterministicInodesEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableMetadataCacheClock)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--metadata-cache-clock", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.isMetadataCacheClockEnabled());
+}
+
 TEST_F(OptionsTest, parseCommandLineShouldSetTagOnCreate)
 {
     cmdArgs.insert(
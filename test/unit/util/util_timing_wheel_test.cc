@@ -0,0 +1,81 @@
+/**
+ * @file util_timing_wheel_test.cc
+ * @author agent
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "util/timingWheel.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace ::testing;
+using namespace one::client::util;
+using namespace std::literals;
+
+TEST(TimingWheelTest, scheduledTaskShouldRunAfterDelay)
+{
+    TimingWheel wheel{1ms, 8};
+    std::promise<std::chrono::steady_clock::time_point> ran;
+
+    const auto start = std::chrono::steady_clock::now();
+    wheel.schedule(
+        20ms, [&] { ran.set_value(std::chrono::steady_clock::now()); });
+
+    auto future = ran.get_future();
+    ASSERT_EQ(std::future_status::ready, future.wait_for(5s));
+    ASSERT_GE(future.get() - start, 20ms);
+}
+
+TEST(TimingWheelTest, scheduledTaskShouldRunAfterManyRevolutions)
+{
+    TimingWheel wheel{1ms, 4};
+    std::promise<void> ran;
+
+    wheel.schedule(30ms, [&] { ran.set_value(); });
+
+    ASSERT_EQ(std::future_status::ready, ran.get_future().wait_for(5s));
+    ASSERT_EQ(0, wheel.size());
+}
+
+TEST(TimingWheelTest, cancelledTaskShouldNotRun)
+{
+    TimingWheel wheel{1ms, 8};
+    std::atomic<bool> cancelledRan{false};
+    std::promise<void> ran;
+
+    auto cancel = wheel.schedule(10ms, [&] { cancelledRan = true; });
+    cancel();
+    wheel.schedule(20ms, [&] { ran.set_value(); });
+
+    ASSERT_EQ(std::future_status::ready, ran.get_future().wait_for(5s));
+    ASSERT_FALSE(cancelledRan);
+}
+
+TEST(TimingWheelTest, cancelAfterTaskRunShouldBeNoop)
+{
+    TimingWheel wheel{1ms, 8};
+    std::promise<void> ran;
+
+    auto cancel = wheel.schedule(1ms, [&] { ran.set_value(); });
+
+    ASSERT_EQ(std::future_status::ready, ran.get_future().wait_for(5s));
+    cancel();
+}
+
+TEST(TimingWheelTest, destructorShouldDropArmedTimers)
+{
+    std::atomic<bool> ran{false};
+    {
+        TimingWheel wheel{1ms, 8};
+        wheel.schedule(1h, [&] { ran = true; });
+        ASSERT_EQ(1, wheel.size());
+    }
+    ASSERT_FALSE(ran);
+}